@@ -0,0 +1,48 @@
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <random>
+
+#include "LogGenerator.h"
+
+int64_t GenerateLog(const char *path, const LogGeneratorOptions& options) {
+    const char *months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    const int32_t other_codes[] = {200, 200, 200, 200, 200, 200, 304, 302, 404, 403};
+    FILE *file = fopen(path, "w");
+    if (file == nullptr) {
+        return -1;
+    }
+    std::mt19937_64 random(239);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    int64_t time = options.start_time;
+    int64_t bytes = 0;
+    char line[512];
+    for (int64_t i = 0; i < options.lines; ++i) {
+        if (uniform(random) * options.requests_per_second < 1.0) {
+            ++time;
+        }
+        int64_t line_time = time;
+        if (options.disorder > 0) {
+            line_time -= static_cast<int64_t>(random() % (options.disorder + 1));
+        }
+        // как у настоящих сайтов: немного очень популярных страниц и длинный хвост
+        int32_t url = static_cast<int32_t>(options.urls * std::pow(uniform(random), 3.0));
+        int32_t code = uniform(random) < options.error_rate ? 500 + static_cast<int32_t>(random() % 4)
+                                                            : other_codes[random() % 10];
+        time_t seconds = line_time - 4 * 3600;
+        std::tm dt{};
+        gmtime_r(&seconds, &dt);
+        int length = snprintf(line, sizeof(line),
+                              "host%u.example.com - - [%02d/%s/%04d:%02d:%02d:%02d -0400] "
+                              "\"GET /shuttle/missions/page%d.html HTTP/1.0\" %d %u\n",
+                              static_cast<uint32_t>(random() % 5000), dt.tm_mday, months[dt.tm_mon],
+                              dt.tm_year + 1900, dt.tm_hour, dt.tm_min, dt.tm_sec, url, code,
+                              static_cast<uint32_t>(random() % 100000));
+        fwrite(line, 1, length, file);
+        bytes += length;
+    }
+    if (fclose(file) != 0) {
+        return -1;
+    }
+    return bytes;
+}
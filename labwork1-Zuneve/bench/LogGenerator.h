@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+// Параметры синтетического лога в формате логов NASA.
+struct LogGeneratorOptions {
+    int64_t lines = 1000000;
+    int32_t urls = 10000;              // число разных адресов, популярность убывает степенным законом
+    double error_rate = 0.01;          // доля ответов 5XX
+    int32_t disorder = 0;              // на сколько секунд строка может отставать от предыдущих
+    int32_t requests_per_second = 20;  // в среднем
+    int64_t start_time = 804571200;    // 01/Jul/1995:00:00:00 -0000
+};
+
+// Пишет лог в path. Возвращает число записанных байт, -1 при ошибке.
+int64_t GenerateLog(const char *path, const LogGeneratorOptions& options);
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <lib/Analyzer.h>
+#include <lib/ParseArguments.h>
+#include <lib/ParseLog.h>
+
+#include "LogGenerator.h"
+
+// Замер времени работы AnalyzeLog на реальном или синтетическом логе по каждой опции отдельно и вместе:
+// все опции вместе должны стоить примерно как один проход по файлу.
+//
+// Usage: analyzer_bench access.log
+//        analyzer_bench --generate [lines] [urls] [5xx_rate] [disorder_seconds]
+
+double RunScenario(std::vector<const char *> options, const char *log_path) {
+    std::vector<char *> argv;
+    argv.push_back(const_cast<char *>("AnalyzeLog"));
+    for (const char *option: options) {
+        argv.push_back(const_cast<char *>(option));
+    }
+    argv.push_back(const_cast<char *>(log_path));
+
+    Args args;
+    args.input_file = fopen(log_path, "r");
+    if (args.input_file == nullptr) {
+        std::cerr << "Error opening log file!" << std::endl;
+        exit(1);
+    }
+    auto start = std::chrono::steady_clock::now();
+    ParseArguments(static_cast<int32_t>(argv.size()), argv.data(), &args);
+    RunAnalysis(&args);
+    auto finish = std::chrono::steady_clock::now();
+    fclose(args.input_file);
+    return std::chrono::duration<double>(finish - start).count();
+}
+
+struct LogSummary {
+    int64_t lines = 0;
+    int64_t bytes = 0;
+    int64_t first_time = 0;
+    int64_t last_time = 0;
+};
+
+LogSummary SummarizeLog(const char *log_path) {
+    LogSummary summary;
+    FILE *log = fopen(log_path, "r");
+    MappedFile file;
+    if (log == nullptr || !file.Map(log)) {
+        std::cerr << "Error mapping log file!" << std::endl;
+        exit(1);
+    }
+    std::string_view data = file.Data();
+    summary.bytes = static_cast<int64_t>(data.size());
+    bool first = true;
+    size_t pos = 0;
+    while (pos < data.size()) {
+        size_t end = data.find('\n', pos);
+        end = end == std::string_view::npos ? data.size() : end + 1;
+        std::string_view line = data.substr(pos, end - pos);
+        pos = end;
+        ++summary.lines;
+        if (IsStringValid(line)) {
+            int64_t time = GetInfoFromLog(line).time;
+            summary.first_time = first ? time : std::min(summary.first_time, time);
+            summary.last_time = first ? time : std::max(summary.last_time, time);
+            first = false;
+        }
+    }
+    fclose(log);
+    return summary;
+}
+
+void PrintScenario(const char *name, double seconds, const LogSummary& summary) {
+    std::cout << name << seconds << " s, " << summary.lines / seconds / 1e6 << " M lines/s, "
+              << summary.bytes / seconds / 1e6 << " MB/s\n";
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: analyzer_bench access.log\n"
+                  << "       analyzer_bench --generate [lines] [urls] [5xx_rate] [disorder_seconds]\n";
+        return 1;
+    }
+    const char *log_path = argv[1];
+    bool generated = strcmp(argv[1], "--generate") == 0;
+    if (generated) {
+        LogGeneratorOptions options;
+        if (argc > 2) {
+            options.lines = std::stoll(argv[2]);
+        }
+        if (argc > 3) {
+            options.urls = std::stoi(argv[3]);
+        }
+        if (argc > 4) {
+            options.error_rate = std::stod(argv[4]);
+        }
+        if (argc > 5) {
+            options.disorder = std::stoi(argv[5]);
+        }
+        log_path = "analyzer_bench_access.log";
+        if (GenerateLog(log_path, options) < 0) {
+            std::cerr << "Error writing generated log!\n";
+            return 1;
+        }
+    }
+    LogSummary summary = SummarizeLog(log_path);
+    int64_t span = summary.last_time - summary.first_time;
+    std::string narrow_from = std::to_string(summary.first_time + span / 2);
+    std::string narrow_to = std::to_string(summary.first_time + span / 2 + span / 100);
+    std::string wide_from = std::to_string(summary.first_time + span / 4);
+    std::string wide_to = std::to_string(summary.last_time - span / 4);
+
+    // вывод -p не должен попадать в терминал и влиять на замер
+    std::ofstream null_stream("/dev/null");
+    std::streambuf *cout_buf = std::cout.rdbuf(null_stream.rdbuf());
+
+    double scan = RunScenario({}, log_path);
+    double print = RunScenario({"-p"}, log_path);
+    double stats = RunScenario({"-o", "/dev/null", "-s", "10"}, log_path);
+    double window = RunScenario({"-o", "/dev/null", "-w", "60"}, log_path);
+    double narrow = RunScenario({"-o", "/dev/null", "-s", "10", "-f", narrow_from.c_str(), "-t", narrow_to.c_str()},
+                                log_path);
+    double wide = RunScenario({"-o", "/dev/null", "-s", "10", "-f", wide_from.c_str(), "-t", wide_to.c_str()},
+                              log_path);
+    double combined = RunScenario({"-o", "/dev/null", "-p", "-w", "60", "-s", "10"}, log_path);
+    double mapped = RunScenario({"-m", "-o", "/dev/null", "-p", "-w", "60", "-s", "10"}, log_path);
+    std::string threads = std::to_string(std::max(1u, std::thread::hardware_concurrency()));
+    double parallel = RunScenario({"-j", threads.c_str(), "-o", "/dev/null", "-p", "-w", "60", "-s", "10"}, log_path);
+
+    std::cout.rdbuf(cout_buf);
+    std::cout << summary.lines << " lines, " << summary.bytes << " bytes\n";
+    PrintScenario("scan only:             ", scan, summary);
+    PrintScenario("-p:                    ", print, summary);
+    PrintScenario("-s 10:                 ", stats, summary);
+    PrintScenario("-w 60:                 ", window, summary);
+    PrintScenario("-s 10 --from/--to 1%:  ", narrow, summary);
+    PrintScenario("-s 10 --from/--to 50%: ", wide, summary);
+    std::cout << "separate runs total:    " << print + stats + window << " s\n";
+    PrintScenario("-p -w 60 -s 10:        ", combined, summary);
+    PrintScenario("-m -p -w 60 -s 10:     ", mapped, summary);
+    PrintScenario(("-j " + threads + " -p -w 60 -s 10: ").c_str(), parallel, summary);
+    if (generated) {
+        remove(log_path);
+    }
+    return 0;
+}
@@ -0,0 +1,35 @@
+#include <iostream>
+#include <string>
+
+#include "LogGenerator.h"
+
+// Синтетический access.log для замеров и проверок.
+//
+// Usage: log_generator output.log [lines] [urls] [5xx_rate] [disorder_seconds]
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: log_generator output.log [lines] [urls] [5xx_rate] [disorder_seconds]\n";
+        return 1;
+    }
+    LogGeneratorOptions options;
+    if (argc > 2) {
+        options.lines = std::stoll(argv[2]);
+    }
+    if (argc > 3) {
+        options.urls = std::stoi(argv[3]);
+    }
+    if (argc > 4) {
+        options.error_rate = std::stod(argv[4]);
+    }
+    if (argc > 5) {
+        options.disorder = std::stoi(argv[5]);
+    }
+    int64_t bytes = GenerateLog(argv[1], options);
+    if (bytes < 0) {
+        std::cerr << "Error writing log file!\n";
+        return 1;
+    }
+    std::cout << options.lines << " lines, " << bytes << " bytes\n";
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+
+#include <lib/LineScanner.h>
+#include <lib/LogReader.h>
+#include <lib/ParseLog.h>
+
+// Пропускная способность разбора строк отображённого в память лога:
+// построчный поиск (memchr + IsStringValid + GetInfoFromLog) против блочного сканера ScanLines.
+//
+// Usage: scanner_bench access.log
+
+template<typename Function>
+double MeasureGigabytesPerSecond(std::string_view data, Function function) {
+    auto start = std::chrono::steady_clock::now();
+    int64_t checksum = function(data);
+    auto finish = std::chrono::steady_clock::now();
+    if (checksum == 42) {
+        std::cout << ""; // не даёт выбросить вычисления
+    }
+    return data.size() / std::chrono::duration<double>(finish - start).count() / 1e9;
+}
+
+int64_t ParseLineByLine(std::string_view data) {
+    int64_t checksum = 0;
+    size_t pos = 0;
+    while (pos < data.size()) {
+        size_t end = data.find('\n', pos);
+        end = end == std::string_view::npos ? data.size() : end + 1;
+        std::string_view line = data.substr(pos, end - pos);
+        pos = end;
+        if (IsStringValid(line)) {
+            InfoFromLog info = GetInfoFromLog(line);
+            checksum += info.time + info.code + info.request.size();
+        }
+    }
+    return checksum;
+}
+
+int64_t ParseScanned(std::string_view data) {
+    constexpr size_t lines_per_scan = 256;
+    LineFields fields[lines_per_scan];
+    int64_t checksum = 0;
+    while (!data.empty()) {
+        size_t consumed;
+        size_t lines = ScanLines(data, fields, lines_per_scan, consumed);
+        size_t line_start = 0;
+        for (size_t i = 0; i < lines; ++i) {
+            std::string_view line = data.substr(line_start, fields[i].length);
+            line_start += fields[i].length;
+            if (fields[i].IsValid()) {
+                InfoFromLog info = GetInfoFromFields(line, fields[i]);
+                checksum += info.time + info.code + info.request.size();
+            }
+        }
+        data.remove_prefix(consumed);
+    }
+    return checksum;
+}
+
+int64_t SplitLineByLine(std::string_view data) {
+    int64_t checksum = 0;
+    size_t pos = 0;
+    while (pos < data.size()) {
+        size_t end = data.find('\n', pos);
+        end = end == std::string_view::npos ? data.size() : end + 1;
+        std::string_view line = data.substr(pos, end - pos);
+        pos = end;
+        checksum += IsStringValid(line) + line.find('"') + line.rfind('"') + line.find('[');
+    }
+    return checksum;
+}
+
+int64_t SplitScanned(std::string_view data) {
+    constexpr size_t lines_per_scan = 256;
+    LineFields fields[lines_per_scan];
+    int64_t checksum = 0;
+    while (!data.empty()) {
+        size_t consumed;
+        size_t lines = ScanLines(data, fields, lines_per_scan, consumed);
+        for (size_t i = 0; i < lines; ++i) {
+            checksum += fields[i].IsValid() + fields[i].first_quote + fields[i].last_quote + fields[i].open_bracket;
+        }
+        data.remove_prefix(consumed);
+    }
+    return checksum;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        std::cerr << "Usage: scanner_bench access.log\n";
+        return 1;
+    }
+    FILE *log = fopen(argv[1], "r");
+    MappedFile file;
+    if (log == nullptr || !file.Map(log)) {
+        std::cerr << "Error mapping log file!\n";
+        return 1;
+    }
+    std::string_view data = file.Data();
+    if (ParseLineByLine(data) != ParseScanned(data)) {
+        std::cerr << "results differ!\n";
+        return 1;
+    }
+    std::cout << "scanner: " << ScannerInstructionSet() << "\n"
+              << "split + find fields, line by line: " << MeasureGigabytesPerSecond(data, SplitLineByLine)
+              << " GB/s\n"
+              << "split + find fields, ScanLines:    " << MeasureGigabytesPerSecond(data, SplitScanned) << " GB/s\n"
+              << "full parse, line by line:          " << MeasureGigabytesPerSecond(data, ParseLineByLine)
+              << " GB/s\n"
+              << "full parse, ScanLines:             " << MeasureGigabytesPerSecond(data, ParseScanned) << " GB/s\n";
+    fclose(log);
+    return 0;
+}
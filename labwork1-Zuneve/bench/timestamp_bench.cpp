@@ -0,0 +1,61 @@
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <lib/ParseLog.h>
+#include <lib/TimestampParser.h>
+
+// Сравнение ParseDateToTimestamp (sscanf + timegm) с TimestampParser на последовательных датах лога.
+//
+// Usage: timestamp_bench [count]
+
+std::vector<std::string> MakeDates(size_t count) {
+    const char *months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    std::vector<std::string> dates;
+    dates.reserve(count);
+    time_t time = 804571201;
+    char buffer[32];
+    for (size_t i = 0; i < count; ++i) {
+        time += i % 3; // как в логе: несколько запросов в секунду, дата меняется редко
+        std::tm dt{};
+        gmtime_r(&time, &dt);
+        snprintf(buffer, sizeof(buffer), "%02d/%s/%04d:%02d:%02d:%02d -0400", dt.tm_mday, months[dt.tm_mon],
+                 dt.tm_year + 1900, dt.tm_hour, dt.tm_min, dt.tm_sec);
+        dates.emplace_back(buffer);
+    }
+    return dates;
+}
+
+int main(int argc, char **argv) {
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 5000000;
+    std::vector<std::string> dates = MakeDates(count);
+
+    int64_t slow_sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string& date: dates) {
+        slow_sum += ParseDateToTimestamp(date.c_str());
+    }
+    auto middle = std::chrono::steady_clock::now();
+    TimestampParser parser;
+    int64_t fast_sum = 0;
+    for (const std::string& date: dates) {
+        int64_t timestamp = 0;
+        parser.Parse(date, timestamp);
+        fast_sum += timestamp;
+    }
+    auto finish = std::chrono::steady_clock::now();
+
+    double slow = std::chrono::duration<double, std::nano>(middle - start).count() / count;
+    double fast = std::chrono::duration<double, std::nano>(finish - middle).count() / count;
+    std::cout << "sscanf + timegm:  " << slow << " ns/date\n"
+              << "TimestampParser:  " << fast << " ns/date\n"
+              << "speedup:          " << slow / fast << "x\n";
+    if (slow_sum != fast_sum) {
+        std::cerr << "results differ!\n";
+        return 1;
+    }
+    return 0;
+}
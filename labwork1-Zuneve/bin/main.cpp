@@ -0,0 +1,30 @@
+#include <cstring>
+#include <iostream>
+
+#include <lib/Analyzer.h>
+#include <lib/ParseArguments.h>
+
+signed main(int32_t argc, char **argv) {
+    if (NeedsHelp(argc, argv)) {
+        PrintHelp();
+        return 0;
+    }
+    Args args;
+    if (strcmp(argv[argc - 1], "-") == 0) {
+        args.input_file = stdin;
+        args.streaming = true;
+    } else {
+        args.input_file = fopen(argv[argc - 1], "r");
+    }
+    if (args.input_file == nullptr) {
+        std::cerr << "Error opening log file!" << std::endl;
+        Error();
+        return 0;
+    }
+    if (!ParseArguments(argc, argv, &args) || !RunAnalysis(&args)) {
+        return 0;
+    }
+    fclose(args.input_file);
+    args.output_file.close();
+    return 0;
+}
@@ -0,0 +1,327 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "Analyzer.h"
+#include "CompressedLogReader.h"
+#include "ParallelAnalyzer.h"
+#include "ParseArguments.h"
+#include "LineScanner.h"
+#include "ParseLog.h"
+#include "TimeSeek.h"
+
+bool PrepareAnalysis(Args *args, Analysis *analysis) {
+    for (const std::pair<char, const char *>& argument: args->command_line_arguments) {
+        if (argument.first == 'p') {
+            analysis->print_errors = true;
+        } else if (argument.first == 'w') {
+            if (!IsNumber(argument.second)) {
+                Error();
+                return false;
+            }
+            WindowData window_data;
+            window_data.time_in_window = std::stoi(argument.second);
+            if (window_data.time_in_window != 0) {
+                analysis->windows.push_back(window_data);
+            }
+        }
+    }
+    if (args->streaming) {
+        // гистограмма за всё время работы не ограничена по памяти, окна считаются на лету
+        for (const WindowData& window_data: analysis->windows) {
+            analysis->sliding_windows.emplace_back(window_data.time_in_window);
+        }
+    } else {
+        // все окна считаются по одной гистограмме запросов по секундам
+        analysis->collect_histogram = !analysis->windows.empty();
+    }
+    // топ запросов пишется только в output_file, без него считать его незачем
+    analysis->collect_stats = args->output_file.is_open();
+    if (args->approx_counters > 0) {
+        analysis->approximate_stats = true;
+        analysis->heavy_hitters = HeavyHitters(args->approx_counters);
+    }
+    if (args->series_path != nullptr) {
+        analysis->collect_series = true;
+        analysis->series = TimeSeries(args->series_bucket, args->series_endpoints);
+    }
+    return true;
+}
+
+void AddStats(std::string_view request, Analysis *analysis) {
+    if (analysis->approximate_stats) {
+        analysis->heavy_hitters.Add(request);
+    } else {
+        analysis->stats.Add(request);
+    }
+}
+
+void SkipLine(std::string_view line, Analysis *analysis) {
+    if (analysis->index_builder != nullptr) {
+        analysis->index_builder->SkipLine(line);
+    }
+}
+
+void ProcessInfo(std::string_view line, const InfoFromLog& info, Args *args, Analysis *analysis) {
+    if (analysis->index_builder != nullptr) {
+        // в индекс попадают все строки, а не только из --from/--to
+        analysis->index_builder->AddLine(line, info);
+    }
+    if (!IsTimeCorrect(info.time, args)) {
+        return;
+    }
+    if (analysis->collect_histogram) {
+        analysis->histogram.Add(info.time);
+    }
+    for (SlidingWindow& sliding_window: analysis->sliding_windows) {
+        sliding_window.Add(info.time);
+    }
+    if (analysis->collect_series) {
+        analysis->series.Add(info.time, info.code, info.request);
+    }
+    if (info.code / 100 != 5) {
+        return;
+    }
+    if (analysis->print_errors) {
+        if (analysis->buffer_errors) {
+            analysis->errors_buffer.append(info.request);
+            analysis->errors_buffer.push_back('\n');
+        } else {
+            analysis->errors_writer->WriteLine(info.request);
+        }
+    }
+    if (analysis->collect_stats) {
+        AddStats(info.request, analysis);
+    }
+}
+
+void ProcessLine(std::string_view line, Args *args, Analysis *analysis) {
+    if (!IsStringValid(line)) {
+        SkipLine(line, analysis);
+        return;
+    }
+    ProcessInfo(line, GetInfoFromLog(line), args, analysis);
+}
+
+void AnalyzeLog(LogReader *reader, Args *args, Analysis *analysis) {
+    std::string_view line;
+    while (reader->NextLine(line)) {
+        ProcessLine(line, args, analysis);
+    }
+}
+
+void AnalyzeMapped(std::string_view data, Args *args, Analysis *analysis) {
+    constexpr size_t lines_per_scan = 256;
+    LineFields fields[lines_per_scan];
+    while (!data.empty()) {
+        size_t consumed;
+        size_t lines = ScanLines(data, fields, lines_per_scan, consumed);
+        size_t line_start = 0;
+        for (size_t i = 0; i < lines; ++i) {
+            std::string_view line = data.substr(line_start, fields[i].length);
+            line_start += fields[i].length;
+            if (fields[i].IsValid()) {
+                ProcessInfo(line, GetInfoFromFields(line, fields[i]), args, analysis);
+            } else {
+                SkipLine(line, analysis);
+            }
+        }
+        data.remove_prefix(consumed);
+    }
+}
+
+void AnalyzeCompressed(CompressedLogReader *reader, Args *args, Analysis *analysis) {
+    std::string_view block;
+    while (reader->NextBlock(block)) {
+        AnalyzeMapped(block, args, analysis);
+    }
+}
+
+void Report(int64_t lines, Args *args, Analysis *analysis) {
+    SetWindowsFromSliding(analysis);
+    args->output_file << "LINES PROCESSED: " << lines << '\n';
+    WriteResults(args, analysis);
+    analysis->errors_writer->Flush();
+}
+
+void AnalyzeStream(LogReader *reader, Args *args, Analysis *analysis) {
+    constexpr int64_t lines_between_clock_checks = 4096;
+    constexpr std::chrono::milliseconds follow_poll_interval(200);
+    const std::chrono::seconds report_interval(args->report_interval);
+    std::chrono::steady_clock::time_point last_report = std::chrono::steady_clock::now();
+    int64_t lines = 0;
+    int64_t reported_lines = 0;
+    std::string_view line;
+
+    auto report_if_needed = [&]() {
+        if (args->report_interval > 0 && lines != reported_lines
+            && std::chrono::steady_clock::now() - last_report >= report_interval) {
+            Report(lines, args, analysis);
+            reported_lines = lines;
+            last_report = std::chrono::steady_clock::now();
+        }
+    };
+    while (true) {
+        while (reader->NextLine(line)) {
+            ProcessLine(line, args, analysis);
+            if (++lines % lines_between_clock_checks == 0) {
+                report_if_needed();
+            }
+        }
+        if (!args->follow) {
+            break;
+        }
+        report_if_needed();
+        // пока новых строк нет, накопленный вывод -p не должен задерживаться
+        analysis->errors_writer->Flush();
+        std::this_thread::sleep_for(follow_poll_interval);
+    }
+}
+
+void SetWindowsFromSliding(Analysis *analysis) {
+    for (size_t i = 0; i < analysis->sliding_windows.size(); ++i) {
+        const MaxWindow& window = analysis->sliding_windows[i].Max();
+        analysis->windows[i].max_requests = window.max_requests;
+        analysis->windows[i].ans_l = window.ans_l;
+        analysis->windows[i].ans_r = window.ans_r;
+    }
+}
+
+void SetWindowsFromHistogram(Analysis *analysis) {
+    std::vector<std::pair<int64_t, int64_t>> seconds = analysis->histogram.Sorted();
+    for (WindowData& window_data: analysis->windows) {
+        MaxWindow window = FindMaxWindow(seconds, window_data.time_in_window);
+        window_data.max_requests = window.max_requests;
+        window_data.ans_l = window.ans_l;
+        window_data.ans_r = window.ans_r;
+    }
+}
+
+void WriteWindow(const WindowData& window_data, BufferedWriter& out) {
+    out.Write("MAX REQUESTS: ");
+    out.Write(window_data.max_requests);
+    out.Write("\nFirst window timestamp: ");
+    out.Write(window_data.ans_l);
+    out.Write("\nLast window timestamp: ");
+    out.Write(window_data.ans_r);
+    out.Write("\n");
+}
+
+void WriteStats(Analysis *analysis, Args *args, BufferedWriter& out) {
+    if (analysis->approximate_stats) {
+        for (const HeavyHitter& request: analysis->heavy_hitters.Top(args->stats_n)) {
+            out.Write(request.request);
+            out.Write(" [");
+            out.Write(request.count - request.error);
+            out.Write(", ");
+            out.Write(request.count);
+            out.Write("]\n");
+        }
+        return;
+    }
+    for (const std::pair<std::string_view, int64_t>& request: analysis->stats.Top(args->stats_n)) {
+        out.WriteLine(request.first);
+    }
+}
+
+void WriteResults(Args *args, Analysis *analysis) {
+    BufferedWriter out(args->output_file);
+    for (const WindowData& window_data: analysis->windows) {
+        WriteWindow(window_data, out);
+    }
+    if (analysis->collect_stats) {
+        WriteStats(analysis, args, out);
+    }
+}
+
+void AnalyzeIndex(const LogIndex& index, Args *args, Analysis *analysis) {
+    size_t begin = index.LowerBound(args->start_time);
+    size_t end = index.UpperBound(args->finish_time);
+    std::vector<size_t> errors;
+    for (size_t i = begin; i < end; ++i) {
+        if (analysis->collect_histogram) {
+            analysis->histogram.Add(index.Time(i));
+        }
+        if (analysis->collect_series) {
+            analysis->series.Add(index.Time(i), index.Status(i), index.Request(i));
+        }
+        if (index.Status(i) / 100 != 5) {
+            continue;
+        }
+        if (analysis->print_errors) {
+            errors.push_back(i);
+        }
+        if (analysis->collect_stats) {
+            AddStats(index.Request(i), analysis);
+        }
+    }
+    // индекс упорядочен по времени, а -p выводит запросы в порядке строк лога
+    std::sort(errors.begin(), errors.end(), [&index](size_t a, size_t b) {
+        return index.Offset(a) < index.Offset(b);
+    });
+    for (size_t i: errors) {
+        analysis->errors_writer->WriteLine(index.Request(i));
+    }
+}
+
+bool RunAnalysis(Args *args) {
+    Analysis analysis;
+    BufferedWriter errors_writer(std::cout);
+    analysis.errors_writer = &errors_writer;
+    if (!PrepareAnalysis(args, &analysis)) {
+        return false;
+    }
+    if (!args->follow) {
+        args->compression = DetectCompression(args->input_file, args->input_prefix);
+    }
+    LogIndex index;
+    if (args->streaming) {
+        std::unique_ptr<LogReader> reader = OpenLogReader(args);
+        AnalyzeStream(reader.get(), args, &analysis);
+        SetWindowsFromSliding(&analysis);
+        if (reader->Failed()) {
+            std::cerr << "Error decompressing log file!\n";
+            return false;
+        }
+    } else if (args->index_path != nullptr && index.Open(args->index_path, args->input_file)) {
+        AnalyzeIndex(index, args, &analysis);
+        SetWindowsFromHistogram(&analysis);
+    } else {
+        std::unique_ptr<IndexBuilder> index_builder;
+        if (args->index_path != nullptr) {
+            // индекс строится одним потоком, чтобы смещения строк шли подряд
+            index_builder = std::make_unique<IndexBuilder>();
+            analysis.index_builder = index_builder.get();
+        }
+        if (args->compression != Compression::none) {
+            // сжатый файл нельзя ни отобразить в память, ни поделить на части
+            CompressedLogReader reader(args->input_file, args->compression, args->input_prefix);
+            AnalyzeCompressed(&reader, args, &analysis);
+            if (reader.Failed()) {
+                std::cerr << "Error decompressing log file!\n";
+                return false;
+            }
+        } else if (index_builder != nullptr || args->threads <= 1 || !AnalyzeLogParallel(args, &analysis)) {
+            MappedFile file;
+            // для поиска по времени нужен произвольный доступ, поэтому файл отображается и без -m
+            bool seek = index_builder == nullptr && CanSeekTime(args);
+            if ((args->use_mmap || seek) && file.Map(args->input_file)) {
+                AnalyzeMapped(seek ? SeekTimeRange(file.Data(), args) : file.Data(), args, &analysis);
+            } else {
+                // не обычный файл (pipe, устройство) - читаем построчно
+                std::unique_ptr<LogReader> reader = OpenLogReader(args);
+                AnalyzeLog(reader.get(), args, &analysis);
+            }
+        }
+        SetWindowsFromHistogram(&analysis);
+        if (index_builder != nullptr && !index_builder->Write(args->index_path, args->input_file)) {
+            std::cerr << "Error writing index file!\n";
+        }
+    }
+    WriteResults(args, &analysis);
+    if (analysis.collect_series && !analysis.series.WriteCsv(args->series_path, args->series_endpoints)) {
+        std::cerr << "Error writing time series file!\n";
+    }
+    return true;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "BufferedWriter.h"
+#include "CompressedLogReader.h"
+#include "HeavyHitters.h"
+#include "LogIndex.h"
+#include "LogReader.h"
+#include "LogStructs.h"
+#include "RequestHistogram.h"
+#include "RequestStats.h"
+#include "TimeSeries.h"
+
+struct WindowData {
+    int32_t time_in_window = 0;
+    int64_t max_requests = 0;
+    int64_t ans_l = 0;
+    int64_t ans_r = 0;
+};
+
+// Состояние всех запрошенных анализов: каждая строка лога разбирается один раз
+// и сразу передаётся во все включённые обработчики.
+struct Analysis {
+    bool print_errors = false;
+    bool buffer_errors = false; // копить вывод -p в errors_buffer вместо errors_writer
+    bool collect_stats = false;
+    bool approximate_stats = false; // топ в heavy_hitters вместо stats
+    bool collect_histogram = false;
+    bool collect_series = false;
+    std::vector<WindowData> windows;
+    RequestStats stats;
+    HeavyHitters heavy_hitters;
+    RequestHistogram histogram;
+    TimeSeries series;
+    std::vector<SlidingWindow> sliding_windows; // вместо гистограммы в потоковом режиме
+    std::string errors_buffer;
+    BufferedWriter *errors_writer = nullptr; // вывод -p в std::cout
+    IndexBuilder *index_builder = nullptr; // если задан, каждая строка ещё и записывается в индекс
+};
+
+bool PrepareAnalysis(Args *args, Analysis *analysis);
+
+void ProcessLine(std::string_view line, Args *args, Analysis *analysis);
+
+void AnalyzeLog(LogReader *reader, Args *args, Analysis *analysis);
+
+// Разбор отображённого в память лога: ScanLines находит строки и поля блоками по несколько сотен строк.
+void AnalyzeMapped(std::string_view data, Args *args, Analysis *analysis);
+
+// Распаковка идёт в своём потоке, а готовые куски строк разбираются так же, как отображённый лог.
+void AnalyzeCompressed(CompressedLogReader *reader, Args *args, Analysis *analysis);
+
+// Читает строки по мере появления и каждые args->report_interval секунд дописывает
+// текущие результаты в output_file. С --follow не завершается сам.
+void AnalyzeStream(LogReader *reader, Args *args, Analysis *analysis);
+
+// Тот же анализ по готовому индексу: читаются только записи из [start_time, finish_time].
+void AnalyzeIndex(const LogIndex& index, Args *args, Analysis *analysis);
+
+void SetWindowsFromHistogram(Analysis *analysis);
+
+void SetWindowsFromSliding(Analysis *analysis);
+
+void WriteResults(Args *args, Analysis *analysis);
+
+bool RunAnalysis(Args *args);
@@ -0,0 +1,43 @@
+#include <charconv>
+#include <cstring>
+
+#include "BufferedWriter.h"
+
+BufferedWriter::BufferedWriter(std::ostream& stream, size_t capacity) : stream_(stream), buffer_(capacity) {
+}
+
+void BufferedWriter::Write(std::string_view str) {
+    if (size_ + str.size() > buffer_.size()) {
+        Flush();
+        if (str.size() > buffer_.size()) {
+            // длиннее всего буфера - копировать незачем
+            stream_.write(str.data(), static_cast<std::streamsize>(str.size()));
+            return;
+        }
+    }
+    memcpy(buffer_.data() + size_, str.data(), str.size());
+    size_ += str.size();
+}
+
+void BufferedWriter::Write(int64_t number) {
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number);
+    Write(std::string_view(digits, result.ptr - digits));
+}
+
+void BufferedWriter::WriteLine(std::string_view line) {
+    Write(line);
+    Write(std::string_view("\n"));
+}
+
+void BufferedWriter::Flush() {
+    if (size_ > 0) {
+        stream_.write(buffer_.data(), static_cast<std::streamsize>(size_));
+        size_ = 0;
+    }
+    stream_.flush();
+}
+
+BufferedWriter::~BufferedWriter() {
+    Flush();
+}
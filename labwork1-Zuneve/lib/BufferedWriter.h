@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+// Вывод большими кусками: строки копируются в буфер и уходят в поток одним write,
+// когда буфер заполнен или при явном Flush. В деструкторе остаток дописывается.
+class BufferedWriter {
+    std::ostream& stream_;
+    std::vector<char> buffer_;
+    size_t size_ = 0;
+
+public:
+    explicit BufferedWriter(std::ostream& stream, size_t capacity = (1 << 20));
+
+    BufferedWriter(const BufferedWriter&) = delete;
+
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    void Write(std::string_view str);
+
+    void Write(int64_t number);
+
+    void WriteLine(std::string_view line);
+
+    void Flush();
+
+    ~BufferedWriter();
+};
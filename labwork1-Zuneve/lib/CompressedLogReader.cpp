@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <cstring>
+
+#ifdef ANALYZELOG_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef ANALYZELOG_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "CompressedLogReader.h"
+
+constexpr size_t ring_capacity = (1 << 22);
+constexpr size_t input_chunk_size = (1 << 18);
+constexpr size_t output_chunk_size = (1 << 18);
+constexpr size_t block_capacity = (1 << 20);
+
+Compression DetectCompression(FILE *file, std::string& prefix) {
+    constexpr char gzip_magic[] = {'\x1f', '\x8b'};
+    constexpr char zstd_magic[] = {'\x28', '\xb5', '\x2f', '\xfd'};
+    long start = ftell(file);
+    prefix.clear();
+    for (int c; prefix.size() < sizeof(zstd_magic) && (c = getc(file)) != EOF;) {
+        prefix.push_back(static_cast<char>(c));
+    }
+    Compression compression = Compression::none;
+    if (prefix.size() >= sizeof(gzip_magic) && memcmp(prefix.data(), gzip_magic, sizeof(gzip_magic)) == 0) {
+        compression = Compression::gzip;
+    } else if (prefix.size() == sizeof(zstd_magic) && memcmp(prefix.data(), zstd_magic, sizeof(zstd_magic)) == 0) {
+        compression = Compression::zstd;
+    }
+    if (start >= 0 && fseek(file, start, SEEK_SET) == 0) {
+        // обычный файл перематывается, прочитанные байты прочитаются ещё раз
+        prefix.clear();
+    }
+    return compression;
+}
+
+size_t ReadInput(FILE *file, std::string& prefix, char *buffer, size_t size) {
+    // сначала байты, прочитанные DetectCompression из неперематываемого входа
+    size_t from_prefix = std::min(size, prefix.size());
+    memcpy(buffer, prefix.data(), from_prefix);
+    prefix.erase(0, from_prefix);
+    return from_prefix + fread(buffer + from_prefix, 1, size - from_prefix, file);
+}
+
+ByteRing::ByteRing(size_t capacity) : data_(new char[capacity]), capacity_(capacity) {
+}
+
+bool ByteRing::Write(const char *data, size_t size) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (size > 0) {
+        not_full_.wait(lock, [this]() { return closed_ || size_ < capacity_; });
+        if (closed_) {
+            return false;
+        }
+        size_t tail = (head_ + size_) % capacity_;
+        size_t part = std::min({size, capacity_ - size_, capacity_ - tail});
+        memcpy(data_.get() + tail, data, part);
+        size_ += part;
+        data += part;
+        size -= part;
+        not_empty_.notify_one();
+    }
+    return true;
+}
+
+size_t ByteRing::Read(char *out, size_t max_size) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this]() { return closed_ || size_ > 0; });
+    size_t read = 0;
+    while (read < max_size && size_ > 0) {
+        size_t part = std::min({max_size - read, size_, capacity_ - head_});
+        memcpy(out + read, data_.get() + head_, part);
+        head_ = (head_ + part) % capacity_;
+        size_ -= part;
+        read += part;
+    }
+    not_full_.notify_one();
+    return read;
+}
+
+void ByteRing::Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    not_empty_.notify_all();
+    not_full_.notify_all();
+}
+
+#ifdef ANALYZELOG_HAVE_ZLIB
+bool InflateGzip(FILE *file, std::string& prefix, ByteRing& ring) {
+    z_stream stream{};
+    // 16 - только формат gzip
+    if (inflateInit2(&stream, 15 + 16) != Z_OK) {
+        return false;
+    }
+    std::vector<char> input(input_chunk_size);
+    std::vector<char> output(output_chunk_size);
+    int status = Z_OK;
+    bool ok = true;
+    while (ok) {
+        if (stream.avail_in == 0) {
+            size_t read = ReadInput(file, prefix, input.data(), input.size());
+            if (read == 0) {
+                break;
+            }
+            stream.next_in = reinterpret_cast<Bytef *>(input.data());
+            stream.avail_in = static_cast<uInt>(read);
+        }
+        stream.next_out = reinterpret_cast<Bytef *>(output.data());
+        stream.avail_out = static_cast<uInt>(output.size());
+        status = inflate(&stream, Z_NO_FLUSH);
+        if (status != Z_OK && status != Z_STREAM_END) {
+            ok = false;
+            break;
+        }
+        ok = ring.Write(output.data(), output.size() - stream.avail_out);
+        if (status == Z_STREAM_END) {
+            // gzip может состоять из нескольких склеенных частей
+            inflateReset(&stream);
+        }
+    }
+    inflateEnd(&stream);
+    return ok && status == Z_STREAM_END;
+}
+#endif
+
+#ifdef ANALYZELOG_HAVE_ZSTD
+bool DecompressZstd(FILE *file, std::string& prefix, ByteRing& ring) {
+    ZSTD_DCtx *context = ZSTD_createDCtx();
+    if (context == nullptr) {
+        return false;
+    }
+    std::vector<char> input(input_chunk_size);
+    std::vector<char> output(output_chunk_size);
+    size_t status = 0; // 0 - последний кадр дочитан до конца
+    bool ok = true;
+    while (ok) {
+        size_t read = ReadInput(file, prefix, input.data(), input.size());
+        if (read == 0) {
+            break;
+        }
+        ZSTD_inBuffer in_buffer = {input.data(), read, 0};
+        while (ok && in_buffer.pos < in_buffer.size) {
+            ZSTD_outBuffer out_buffer = {output.data(), output.size(), 0};
+            status = ZSTD_decompressStream(context, &out_buffer, &in_buffer);
+            ok = !ZSTD_isError(status) && ring.Write(output.data(), out_buffer.pos);
+        }
+    }
+    ZSTD_freeDCtx(context);
+    return ok && status == 0;
+}
+#endif
+
+void CompressedLogReader::Decompress(FILE *file, Compression compression) {
+    bool ok = false;
+#ifdef ANALYZELOG_HAVE_ZLIB
+    if (compression == Compression::gzip) {
+        ok = InflateGzip(file, prefix_, ring_);
+    }
+#endif
+#ifdef ANALYZELOG_HAVE_ZSTD
+    if (compression == Compression::zstd) {
+        ok = DecompressZstd(file, prefix_, ring_);
+    }
+#endif
+    // без нужной библиотеки сжатый лог не читается вовсе
+    failed_ = !ok;
+    ring_.Close();
+}
+
+CompressedLogReader::CompressedLogReader(FILE *file, Compression compression, std::string_view prefix)
+    : ring_(ring_capacity), prefix_(prefix), block_(block_capacity) {
+    decompressor_ = std::thread(&CompressedLogReader::Decompress, this, file, compression);
+}
+
+bool CompressedLogReader::NextBlock(std::string_view& block) {
+    // недочитанная строка с конца прошлого куска переносится в начало
+    filled_ -= block_end_;
+    memmove(block_.data(), block_.data() + block_end_, filled_);
+    block_end_ = 0;
+    line_pos_ = 0;
+    while (true) {
+        if (filled_ == block_.size()) {
+            // строка длиннее буфера
+            block_.resize(block_.size() * 2);
+        }
+        size_t searched = filled_;
+        size_t read = ring_.Read(block_.data() + filled_, block_.size() - filled_);
+        filled_ += read;
+        if (read == 0) {
+            // конец данных: последняя строка может быть без '\n'
+            block_end_ = filled_;
+            break;
+        }
+        const void *last_newline = memrchr(block_.data() + searched, '\n', read);
+        if (last_newline != nullptr) {
+            block_end_ = static_cast<const char *>(last_newline) - block_.data() + 1;
+            break;
+        }
+    }
+    block = std::string_view(block_.data(), block_end_);
+    line_pos_ = block_end_;
+    return block_end_ > 0;
+}
+
+bool CompressedLogReader::NextLine(std::string_view& line) {
+    if (line_pos_ == block_end_) {
+        std::string_view block;
+        if (!NextBlock(block)) {
+            return false;
+        }
+        line_pos_ = 0;
+    }
+    std::string_view rest(block_.data() + line_pos_, block_end_ - line_pos_);
+    size_t end = rest.find('\n');
+    line = rest.substr(0, end == std::string_view::npos ? rest.size() : end + 1);
+    line_pos_ += line.size();
+    return true;
+}
+
+bool CompressedLogReader::Failed() const {
+    return failed_;
+}
+
+CompressedLogReader::~CompressedLogReader() {
+    ring_.Close();
+    decompressor_.join();
+}
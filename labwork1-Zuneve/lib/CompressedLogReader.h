@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "LogReader.h"
+#include "LogStructs.h"
+
+// Сжатие определяется по сигнатуре: gzip начинается с 0x1f 0x8b, zstd - с 0x28 0xb5 0x2f 0xfd.
+// Обычный файл перематывается обратно, а из неперематываемого входа (stdin, pipe) прочитанные
+// байты остаются в prefix, и читатель лога должен выдать их перед остальными.
+Compression DetectCompression(FILE *file, std::string& prefix);
+
+// Кольцевой буфер байт между одним пишущим и одним читающим потоком.
+class ByteRing {
+    std::unique_ptr<char[]> data_;
+    size_t capacity_;
+    size_t head_ = 0; // откуда читать
+    size_t size_ = 0;
+    bool closed_ = false;
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+
+public:
+    explicit ByteRing(size_t capacity);
+
+    // Ждёт свободного места, пока не запишет всё. false, если кольцо закрыто.
+    bool Write(const char *data, size_t size);
+
+    // Ждёт хотя бы одного байта и забирает не больше max_size. 0 - кольцо закрыто и пусто.
+    size_t Read(char *out, size_t max_size);
+
+    // Вызывается любой из сторон: писатель - в конце данных, читатель - когда они больше не нужны.
+    void Close();
+};
+
+// Распаковывает gzip или zstd в отдельном потоке, а строки выдаются по мере распаковки,
+// так что разбор идёт одновременно с чтением и распаковкой и не требует места на диске.
+class CompressedLogReader : public LogReader {
+    ByteRing ring_;
+    std::string prefix_; // начало входа, уже прочитанное DetectCompression
+    std::atomic<bool> failed_ = false;
+    std::vector<char> block_;
+    size_t filled_ = 0;    // сколько байт block_ занято
+    size_t block_end_ = 0; // конец последнего выданного куска
+    size_t line_pos_ = 0;  // начало следующей строки для NextLine
+    std::thread decompressor_;
+
+    void Decompress(FILE *file, Compression compression);
+
+public:
+    CompressedLogReader(FILE *file, Compression compression, std::string_view prefix = {});
+
+    // Следующий кусок распакованного лога из целых строк, действителен до следующего вызова.
+    bool NextBlock(std::string_view& block);
+
+    bool NextLine(std::string_view& line) override;
+
+    bool Failed() const override;
+
+    ~CompressedLogReader() override;
+};
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <utility>
+
+#include "HeavyHitters.h"
+
+HeavyHitters::HeavyHitters(size_t capacity) : capacity_(std::max<size_t>(capacity, 1)) {
+    // без перевыделений строки не сдвигаются и ключи slots_ остаются верными
+    requests_.reserve(capacity_);
+    counts_.reserve(capacity_);
+    errors_.reserve(capacity_);
+    heap_.reserve(capacity_);
+    heap_positions_.reserve(capacity_);
+}
+
+void HeavyHitters::SiftDown(size_t position) {
+    while (true) {
+        size_t smallest = position;
+        for (size_t child = 2 * position + 1; child <= 2 * position + 2 && child < heap_.size(); ++child) {
+            if (counts_[heap_[child]] < counts_[heap_[smallest]]) {
+                smallest = child;
+            }
+        }
+        if (smallest == position) {
+            return;
+        }
+        std::swap(heap_[position], heap_[smallest]);
+        heap_positions_[heap_[position]] = position;
+        heap_positions_[heap_[smallest]] = smallest;
+        position = smallest;
+    }
+}
+
+void HeavyHitters::Add(std::string_view request, int64_t count, int64_t error, std::string *evicted) {
+    auto it = slots_.find(request);
+    if (it != slots_.end()) {
+        counts_[it->second] += count;
+        errors_[it->second] += error;
+        SiftDown(heap_positions_[it->second]);
+        return;
+    }
+    if (heap_.size() < capacity_) {
+        size_t slot = requests_.size();
+        requests_.emplace_back(request);
+        counts_.push_back(count);
+        errors_.push_back(error);
+        heap_positions_.push_back(heap_.size());
+        heap_.push_back(slot);
+        slots_.emplace(requests_[slot], slot);
+        // новый счётчик не меньше count, а все старые уже на своих местах - поднимаем его
+        size_t position = heap_.size() - 1;
+        while (position > 0 && counts_[heap_[(position - 1) / 2]] > counts_[heap_[position]]) {
+            size_t parent = (position - 1) / 2;
+            std::swap(heap_[position], heap_[parent]);
+            heap_positions_[heap_[position]] = position;
+            heap_positions_[heap_[parent]] = parent;
+            position = parent;
+        }
+        return;
+    }
+    // вытесняется самый редкий, его значение становится погрешностью нового
+    size_t slot = heap_[0];
+    slots_.erase(requests_[slot]);
+    if (evicted != nullptr) {
+        evicted->swap(requests_[slot]);
+    }
+    requests_[slot].assign(request);
+    slots_.emplace(requests_[slot], slot);
+    errors_[slot] = counts_[slot] + error;
+    counts_[slot] += count;
+    SiftDown(0);
+}
+
+void HeavyHitters::Merge(const HeavyHitters& other) {
+    // запрос, которого нет в заполненной части, мог быть там вытеснен: его число в ней
+    // не больше её MaxError(), поэтому к оценке и погрешности добавляется MaxError() этой части
+    int64_t this_error = MaxError();
+    int64_t other_error = other.MaxError();
+    std::vector<std::pair<std::string, HeavyHitter>> merged;
+    merged.reserve(requests_.size() + other.requests_.size());
+    for (size_t slot = 0; slot < requests_.size(); ++slot) {
+        auto it = other.slots_.find(requests_[slot]);
+        int64_t count = it != other.slots_.end() ? other.counts_[it->second] : other_error;
+        int64_t error = it != other.slots_.end() ? other.errors_[it->second] : other_error;
+        merged.push_back({requests_[slot], {{}, counts_[slot] + count, errors_[slot] + error}});
+    }
+    for (size_t slot = 0; slot < other.requests_.size(); ++slot) {
+        if (slots_.find(other.requests_[slot]) == slots_.end()) {
+            merged.push_back({other.requests_[slot],
+                              {{}, other.counts_[slot] + this_error, other.errors_[slot] + this_error}});
+        }
+    }
+    // остаются capacity_ наибольших счётчиков
+    size_t kept = std::min(merged.size(), capacity_);
+    std::partial_sort(merged.begin(), merged.begin() + kept, merged.end(), [](const auto& a, const auto& b) {
+        return a.second.count > b.second.count;
+    });
+    slots_.clear();
+    requests_.clear();
+    counts_.clear();
+    errors_.clear();
+    heap_.clear();
+    heap_positions_.clear();
+    for (size_t i = 0; i < kept; ++i) {
+        Add(merged[i].first, merged[i].second.count, merged[i].second.error);
+    }
+}
+
+int64_t HeavyHitters::MaxError() const {
+    return heap_.size() < capacity_ ? 0 : counts_[heap_[0]];
+}
+
+std::vector<HeavyHitter> HeavyHitters::Top(size_t n) const {
+    std::vector<HeavyHitter> top;
+    top.reserve(requests_.size());
+    for (size_t slot = 0; slot < requests_.size(); ++slot) {
+        top.push_back({requests_[slot], counts_[slot], errors_[slot]});
+    }
+    n = std::min(n, top.size());
+    std::partial_sort(top.begin(), top.begin() + n, top.end(), [](const HeavyHitter& a, const HeavyHitter& b) {
+        return a.count > b.count || (a.count == b.count && a.request < b.request);
+    });
+    top.resize(n);
+    return top;
+}
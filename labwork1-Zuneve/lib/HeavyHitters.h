@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Оценка частоты запроса: настоящее число лежит в [count - error, count].
+struct HeavyHitter {
+    std::string_view request;
+    int64_t count;
+    int64_t error;
+};
+
+// Приближённый топ запросов алгоритмом Space-Saving: не больше capacity счётчиков,
+// память не зависит от числа разных запросов. Новый запрос при заполнении вытесняет
+// самый редкий счётчик и наследует его значение как погрешность. Любой запрос, встретившийся
+// больше MaxError() раз, гарантированно есть среди счётчиков.
+class HeavyHitters {
+    size_t capacity_;
+    std::vector<std::string> requests_; // место под текст у каждого счётчика своё и не переезжает
+    std::vector<int64_t> counts_;
+    std::vector<int64_t> errors_;
+    std::vector<size_t> heap_;          // номера счётчиков, на вершине - наименьший
+    std::vector<size_t> heap_positions_;
+    std::unordered_map<std::string_view, size_t> slots_;
+
+    void SiftDown(size_t position);
+
+public:
+    explicit HeavyHitters(size_t capacity = 1024);
+
+    // если при этом вытеснен другой запрос и evicted не nullptr, его текст записывается в evicted
+    void Add(std::string_view request, int64_t count = 1, int64_t error = 0, std::string *evicted = nullptr);
+
+    // Слияние Space-Saving для двух частей данных: счётчики одного запроса складываются, а запросу,
+    // которого нет в заполненной части, добавляется её MaxError() к оценке и к погрешности.
+    // Остаются capacity наибольших счётчиков.
+    void Merge(const HeavyHitters& other);
+
+    size_t Size() const { return heap_.size(); }
+
+    bool Contains(std::string_view request) const { return slots_.contains(request); }
+
+    // наибольшая погрешность любой оценки: наименьший счётчик, если все счётчики заняты
+    int64_t MaxError() const;
+
+    // n запросов с наибольшими оценками по убыванию, при равенстве - по тексту
+    std::vector<HeavyHitter> Top(size_t n) const;
+};
@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ANALYZELOG_X86
+#endif
+
+#include "LineScanner.h"
+
+constexpr size_t block_size = 64;
+
+// Для каждого интересного символа - маска его позиций в блоке из 64 байт.
+struct BlockMasks {
+    uint64_t newline;
+    uint64_t open_bracket;
+    uint64_t close_bracket;
+    uint64_t quote;
+    uint64_t slash;
+    uint64_t dash;
+};
+
+using MasksFunction = BlockMasks (*)(const char *block);
+
+BlockMasks ScalarMasks(const char *block) {
+    BlockMasks masks{};
+    for (size_t i = 0; i < block_size; ++i) {
+        uint64_t bit = uint64_t(1) << i;
+        switch (block[i]) {
+            case '\n':
+                masks.newline |= bit;
+                break;
+            case '[':
+                masks.open_bracket |= bit;
+                break;
+            case ']':
+                masks.close_bracket |= bit;
+                break;
+            case '"':
+                masks.quote |= bit;
+                break;
+            case '/':
+                masks.slash |= bit;
+                break;
+            case '-':
+                masks.dash |= bit;
+                break;
+            default:
+                break;
+        }
+    }
+    return masks;
+}
+
+#ifdef ANALYZELOG_X86
+uint64_t Sse2Mask(const __m128i parts[4], char c) {
+    __m128i pattern = _mm_set1_epi8(c);
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        mask |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(parts[i], pattern)))) << (16 * i);
+    }
+    return mask;
+}
+
+BlockMasks Sse2Masks(const char *block) {
+    __m128i parts[4];
+    for (int i = 0; i < 4; ++i) {
+        parts[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * i));
+    }
+    return {Sse2Mask(parts, '\n'), Sse2Mask(parts, '['), Sse2Mask(parts, ']'),
+            Sse2Mask(parts, '"'), Sse2Mask(parts, '/'), Sse2Mask(parts, '-')};
+}
+
+__attribute__((target("avx2"))) uint64_t Avx2Mask(__m256i low, __m256i high, char c) {
+    __m256i pattern = _mm256_set1_epi8(c);
+    uint64_t low_mask = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, pattern)));
+    uint64_t high_mask = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, pattern)));
+    return low_mask | (high_mask << 32);
+}
+
+__attribute__((target("avx2"))) BlockMasks Avx2Masks(const char *block) {
+    __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+    __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+    return {Avx2Mask(low, high, '\n'), Avx2Mask(low, high, '['), Avx2Mask(low, high, ']'),
+            Avx2Mask(low, high, '"'), Avx2Mask(low, high, '/'), Avx2Mask(low, high, '-')};
+}
+#endif
+
+struct ScannerChoice {
+    MasksFunction masks;
+    const char *name;
+};
+
+ScannerChoice ChooseScanner() {
+#ifdef ANALYZELOG_X86
+    if (__builtin_cpu_supports("avx2")) {
+        return {Avx2Masks, "AVX2"};
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return {Sse2Masks, "SSE2"};
+    }
+#endif
+    return {ScalarMasks, "scalar"};
+}
+
+const ScannerChoice& Scanner() {
+    static const ScannerChoice choice = ChooseScanner();
+    return choice;
+}
+
+const char *ScannerInstructionSet() {
+    return Scanner().name;
+}
+
+// биты с from по to включительно
+uint64_t BitRange(size_t from, size_t to) {
+    uint64_t high = to >= 63 ? ~uint64_t(0) : (uint64_t(1) << (to + 1)) - 1;
+    uint64_t low = from >= 64 ? ~uint64_t(0) : (uint64_t(1) << from) - 1;
+    return high & ~low;
+}
+
+void MarkSlashAndDash(const BlockMasks& masks, uint64_t range, LineFields& line) {
+    if ((masks.slash & range) != 0) {
+        line.chars |= LineFields::has_slash;
+    }
+    if ((masks.dash & range) != 0) {
+        line.chars |= LineFields::has_dash;
+    }
+}
+
+size_t ScanLines(std::string_view data, LineFields *fields, size_t max_lines, size_t& consumed) {
+    MasksFunction masks_function = Scanner().masks;
+    size_t lines = 0;
+    size_t line_start = 0;
+    LineFields line;
+    consumed = 0;
+    if (max_lines == 0) {
+        return 0;
+    }
+    for (size_t block_start = 0; block_start < data.size(); block_start += block_size) {
+        size_t block_length = std::min(block_size, data.size() - block_start);
+        BlockMasks masks;
+        if (block_length == block_size) {
+            masks = masks_function(data.data() + block_start);
+        } else {
+            // хвост дополняется нулями, чтобы не читать за концом отображения
+            char tail[block_size] = {};
+            memcpy(tail, data.data() + block_start, block_length);
+            masks = masks_function(tail);
+        }
+        uint64_t events = masks.newline | masks.open_bracket | masks.close_bracket | masks.quote;
+        size_t segment_start = 0;
+        while (events != 0) {
+            size_t bit = __builtin_ctzll(events);
+            events &= events - 1;
+            uint64_t event = uint64_t(1) << bit;
+            uint32_t position = static_cast<uint32_t>(block_start + bit - line_start);
+            if (masks.newline & event) {
+                MarkSlashAndDash(masks, BitRange(segment_start, bit), line);
+                line.length = position + 1;
+                fields[lines++] = line;
+                line = LineFields();
+                line_start = block_start + bit + 1;
+                segment_start = bit + 1;
+                if (lines == max_lines) {
+                    consumed = line_start;
+                    return lines;
+                }
+            } else if (masks.open_bracket & event) {
+                line.chars |= LineFields::has_open_bracket;
+                if (line.open_bracket == LineFields::line_npos) {
+                    line.open_bracket = position;
+                }
+            } else if (masks.close_bracket & event) {
+                line.chars |= LineFields::has_close_bracket;
+                if (line.open_bracket != LineFields::line_npos && line.close_bracket == LineFields::line_npos) {
+                    line.close_bracket = position;
+                }
+            } else {
+                line.chars |= LineFields::has_quote;
+                if (line.first_quote == LineFields::line_npos) {
+                    line.first_quote = position;
+                }
+                line.last_quote = position;
+            }
+        }
+        if (segment_start < block_length) {
+            MarkSlashAndDash(masks, BitRange(segment_start, block_length - 1), line);
+        }
+    }
+    if (line_start < data.size()) {
+        line.length = data.size() - line_start;
+        fields[lines++] = line;
+    }
+    consumed = data.size();
+    return lines;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Положение полей внутри одной строки лога, найденное блочным сканером.
+// Смещения отсчитываются от начала строки, line_npos - символа в строке нет.
+struct LineFields {
+    static constexpr uint32_t line_npos = UINT32_MAX;
+
+    enum : uint8_t {
+        has_open_bracket = 1,
+        has_close_bracket = 2,
+        has_quote = 4,
+        has_slash = 8,
+        has_dash = 16,
+        has_all = 31
+    };
+
+    size_t length = 0;                  // вместе с '\n', если он есть
+    uint32_t open_bracket = line_npos;  // первая '['
+    uint32_t close_bracket = line_npos; // первая ']' после неё
+    uint32_t first_quote = line_npos;
+    uint32_t last_quote = line_npos;
+    uint8_t chars = 0;                  // какие из символов "[]\"/-" встретились
+
+    // то же, что IsStringValid
+    bool IsValid() const { return chars == has_all; }
+};
+
+// Разбивает data на строки и находит в них поля, обрабатывая по 64 байта за раз (AVX2 или SSE2,
+// если процессор их поддерживает, иначе обычный цикл). Заполняет не больше max_lines записей,
+// в consumed возвращает число байт, занятых найденными строками. Последняя строка без '\n'
+// считается полной: data - всегда весь остаток лога.
+size_t ScanLines(std::string_view data, LineFields *fields, size_t max_lines, size_t& consumed);
+
+// Набор инструкций, выбранный ScanLines на этом процессоре.
+const char *ScannerInstructionSet();
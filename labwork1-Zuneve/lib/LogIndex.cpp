@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <sys/stat.h>
+
+#include "LogIndex.h"
+
+// версия 2: статусы 32-битные
+constexpr char index_magic[8] = {'A', 'L', 'O', 'G', 'I', 'D', 'X', '2'};
+
+bool GetLogVersion(FILE *log, uint64_t& size, int64_t& mtime) {
+    struct stat log_stat{};
+    if (fstat(fileno(log), &log_stat) != 0 || !S_ISREG(log_stat.st_mode)) {
+        return false;
+    }
+    size = log_stat.st_size;
+    mtime = log_stat.st_mtime;
+    return true;
+}
+
+void IndexBuilder::SkipLine(std::string_view line) {
+    offset_ += line.size();
+}
+
+void IndexBuilder::AddLine(std::string_view line, const InfoFromLog& info) {
+    auto it = request_ids_.find(info.request);
+    if (it == request_ids_.end()) {
+        std::string_view request = pool_.Intern(info.request);
+        it = request_ids_.emplace(request, static_cast<uint32_t>(requests_.size())).first;
+        requests_.push_back(request);
+    }
+    times_.push_back(info.time);
+    offsets_.push_back(offset_);
+    ids_.push_back(it->second);
+    statuses_.push_back(static_cast<uint32_t>(info.code));
+    offset_ += line.size();
+}
+
+template<typename T>
+bool WriteColumn(const std::vector<T>& column, const std::vector<size_t>& order, FILE *file) {
+    std::vector<T> sorted(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        sorted[i] = column[order[i]];
+    }
+    return fwrite(sorted.data(), sizeof(T), sorted.size(), file) == sorted.size();
+}
+
+bool IndexBuilder::Write(const char *path, FILE *log) const {
+    IndexHeader header{};
+    memcpy(header.magic, index_magic, sizeof(index_magic));
+    if (!GetLogVersion(log, header.log_size, header.log_mtime)) {
+        return false;
+    }
+    header.lines = times_.size();
+    header.requests = requests_.size();
+
+    // лог почти отсортирован по времени, stable_sort сохраняет порядок строк внутри секунды
+    std::vector<size_t> order(times_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return times_[a] < times_[b];
+    });
+    std::vector<uint64_t> string_offsets;
+    string_offsets.reserve(requests_.size() + 1);
+    string_offsets.push_back(0);
+    for (std::string_view request: requests_) {
+        string_offsets.push_back(string_offsets.back() + request.size());
+    }
+    header.strings_size = string_offsets.back();
+
+    FILE *file = fopen(path, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1
+              && WriteColumn(times_, order, file)
+              && WriteColumn(offsets_, order, file)
+              && fwrite(string_offsets.data(), sizeof(uint64_t), string_offsets.size(), file) == string_offsets.size()
+              && WriteColumn(ids_, order, file)
+              && WriteColumn(statuses_, order, file);
+    for (size_t i = 0; ok && i < requests_.size(); ++i) {
+        ok = fwrite(requests_[i].data(), 1, requests_[i].size(), file) == requests_[i].size();
+    }
+    return fclose(file) == 0 && ok;
+}
+
+bool LogIndex::Open(const char *path, FILE *log) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool mapped = file_.Map(file);
+    fclose(file); // отображение остаётся действительным и без открытого файла
+    std::string_view data = file_.Data();
+    if (!mapped || data.size() < sizeof(IndexHeader)) {
+        return false;
+    }
+    header_ = reinterpret_cast<const IndexHeader *>(data.data());
+    uint64_t log_size;
+    int64_t log_mtime;
+    if (memcmp(header_->magic, index_magic, sizeof(index_magic)) != 0 || !GetLogVersion(log, log_size, log_mtime)
+        || header_->log_size != log_size || header_->log_mtime != log_mtime) {
+        return false;
+    }
+    uint64_t lines = header_->lines;
+    uint64_t expected_size = sizeof(IndexHeader) + lines * (sizeof(int64_t) + sizeof(uint64_t) + sizeof(uint32_t)
+                                                            + sizeof(uint32_t))
+                             + (header_->requests + 1) * sizeof(uint64_t) + header_->strings_size;
+    if (data.size() != expected_size) {
+        return false;
+    }
+    const char *position = data.data() + sizeof(IndexHeader);
+    times_ = reinterpret_cast<const int64_t *>(position);
+    position += lines * sizeof(int64_t);
+    offsets_ = reinterpret_cast<const uint64_t *>(position);
+    position += lines * sizeof(uint64_t);
+    string_offsets_ = reinterpret_cast<const uint64_t *>(position);
+    position += (header_->requests + 1) * sizeof(uint64_t);
+    request_ids_ = reinterpret_cast<const uint32_t *>(position);
+    position += lines * sizeof(uint32_t);
+    statuses_ = reinterpret_cast<const uint32_t *>(position);
+    position += lines * sizeof(uint32_t);
+    chars_ = position;
+    return true;
+}
+
+size_t LogIndex::LowerBound(int64_t time) const {
+    return std::lower_bound(times_, times_ + header_->lines, time) - times_;
+}
+
+size_t LogIndex::UpperBound(int64_t time) const {
+    return std::upper_bound(times_, times_ + header_->lines, time) - times_;
+}
+
+std::string_view LogIndex::Request(size_t i) const {
+    uint32_t id = request_ids_[i];
+    return {chars_ + string_offsets_[id], string_offsets_[id + 1] - string_offsets_[id]};
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "LogReader.h"
+#include "LogStructs.h"
+#include "RequestStats.h"
+
+// Индекс лога для повторных запросов: по одной записи на корректную строку, отсортированные по времени.
+// Формат файла - заголовок и столбцы подряд:
+//   IndexHeader
+//   int64_t  times[lines]
+//   uint64_t offsets[lines]              - смещение строки в логе
+//   uint64_t string_offsets[requests + 1] - границы текстов запросов в chars
+//   uint32_t request_ids[lines]
+//   uint32_t statuses[lines]
+//   char     chars[strings_size]
+struct IndexHeader {
+    char magic[8];
+    uint64_t log_size;   // индекс относится к логу именно такого размера
+    int64_t log_mtime;   // и с таким временем изменения
+    uint64_t lines;
+    uint64_t requests;
+    uint64_t strings_size;
+};
+
+// Собирает индекс во время обычного прохода по логу.
+class IndexBuilder {
+    StringPool pool_;
+    std::unordered_map<std::string_view, uint32_t> request_ids_;
+    std::vector<std::string_view> requests_;
+    std::vector<int64_t> times_;
+    std::vector<uint64_t> offsets_;
+    std::vector<uint32_t> ids_;
+    std::vector<uint32_t> statuses_;
+    uint64_t offset_ = 0;
+
+public:
+    // строка без записи в индексе, только сдвигает смещение
+    void SkipLine(std::string_view line);
+
+    void AddLine(std::string_view line, const InfoFromLog& info);
+
+    bool Write(const char *path, FILE *log) const;
+};
+
+// Индекс, отображённый в память. Поиск по времени - двоичный.
+class LogIndex {
+    MappedFile file_;
+    const IndexHeader *header_ = nullptr;
+    const int64_t *times_ = nullptr;
+    const uint64_t *offsets_ = nullptr;
+    const uint64_t *string_offsets_ = nullptr;
+    const uint32_t *request_ids_ = nullptr;
+    const uint32_t *statuses_ = nullptr;
+    const char *chars_ = nullptr;
+
+public:
+    // false, если индекса нет, он повреждён или построен для другой версии лога
+    bool Open(const char *path, FILE *log);
+
+    size_t Size() const { return header_->lines; }
+
+    // первая запись со временем не меньше time
+    size_t LowerBound(int64_t time) const;
+
+    // первая запись со временем больше time
+    size_t UpperBound(int64_t time) const;
+
+    int64_t Time(size_t i) const { return times_[i]; }
+
+    uint64_t Offset(size_t i) const { return offsets_[i]; }
+
+    int32_t Status(size_t i) const { return static_cast<int32_t>(statuses_[i]); }
+
+    std::string_view Request(size_t i) const;
+};
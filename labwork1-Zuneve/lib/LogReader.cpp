@@ -0,0 +1,95 @@
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "CompressedLogReader.h"
+#include "LogReader.h"
+
+FileLogReader::FileLogReader(FILE *file, std::string_view prefix)
+    : file_(file), line_(new char[max_str_size]), prefix_(prefix) {
+}
+
+bool FileLogReader::NextLine(std::string_view& line) {
+    size_t length = 0;
+    if (!prefix_.empty()) {
+        size_t end = prefix_.find('\n');
+        length = end == std::string::npos ? prefix_.size() : end + 1;
+        memcpy(line_, prefix_.data(), length);
+        prefix_.erase(0, length);
+        if (end != std::string::npos) {
+            line = std::string_view(line_, length);
+            return true;
+        }
+    }
+    // строка дочитывается из файла после байт из prefix_
+    if (fgets(line_ + length, static_cast<int>(max_str_size - length), file_) == nullptr) {
+        line = std::string_view(line_, length);
+        return length > 0;
+    }
+    line = std::string_view(line_, length + strlen(line_ + length));
+    return true;
+}
+
+FileLogReader::~FileLogReader() {
+    delete[] line_;
+}
+
+FollowLogReader::FollowLogReader(FILE *file) : file_(file), chunk_(new char[max_str_size]) {
+}
+
+bool FollowLogReader::NextLine(std::string_view& line) {
+    if (line_returned_) {
+        line_.clear();
+        line_returned_ = false;
+    }
+    while (fgets(chunk_, max_str_size, file_) != nullptr) {
+        line_.append(chunk_);
+        if (line_.back() == '\n') {
+            line = line_;
+            line_returned_ = true;
+            return true;
+        }
+    }
+    clearerr(file_); // иначе fgets больше не увидит дописанные данные
+    return false;
+}
+
+FollowLogReader::~FollowLogReader() {
+    delete[] chunk_;
+}
+
+bool MappedFile::Map(FILE *file) {
+    int fd = fileno(file);
+    struct stat file_stat{};
+    if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode)) {
+        return false;
+    }
+    size_ = file_stat.st_size;
+    if (size_ == 0) {
+        return true;
+    }
+    void *mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+        size_ = 0;
+        return false;
+    }
+    madvise(mapped, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char *>(mapped);
+    return true;
+}
+
+MappedFile::~MappedFile() {
+    if (data_ != nullptr) {
+        munmap(const_cast<char *>(data_), size_);
+    }
+}
+
+std::unique_ptr<LogReader> OpenLogReader(Args *args) {
+    if (args->follow) {
+        return std::make_unique<FollowLogReader>(args->input_file);
+    }
+    if (args->compression != Compression::none) {
+        return std::make_unique<CompressedLogReader>(args->input_file, args->compression, args->input_prefix);
+    }
+    return std::make_unique<FileLogReader>(args->input_file, args->input_prefix);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "LogStructs.h"
+
+// Источник строк лога. Строка, выданная NextLine, действительна до следующего вызова NextLine.
+class LogReader {
+public:
+    virtual bool NextLine(std::string_view& line) = 0;
+
+    // true, если строки кончились из-за ошибки, а не конца лога
+    virtual bool Failed() const { return false; }
+
+    virtual ~LogReader() = default;
+};
+
+// Построчное чтение через fgets в буфер размера max_str_size.
+// prefix - уже прочитанное из file начало, выдаётся первым.
+class FileLogReader : public LogReader {
+    FILE *file_;
+    char *line_;
+    std::string prefix_;
+
+public:
+    explicit FileLogReader(FILE *file, std::string_view prefix = {});
+
+    bool NextLine(std::string_view& line) override;
+
+    ~FileLogReader() override;
+};
+
+// Чтение растущего файла: на конце файла NextLine возвращает false, но следующий вызов
+// продолжит с того же места. Недописанная последняя строка придерживается до появления '\n'.
+class FollowLogReader : public LogReader {
+    FILE *file_;
+    char *chunk_;
+    std::string line_;
+    bool line_returned_ = false;
+
+public:
+    explicit FollowLogReader(FILE *file);
+
+    bool NextLine(std::string_view& line) override;
+
+    ~FollowLogReader() override;
+};
+
+// Обычный файл, целиком отображённый в память только для чтения.
+class MappedFile {
+    const char *data_ = nullptr;
+    size_t size_ = 0;
+
+public:
+    MappedFile() = default;
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Map(FILE *file);
+
+    std::string_view Data() const { return {data_, size_}; }
+
+    ~MappedFile();
+};
+
+std::unique_ptr<LogReader> OpenLogReader(Args *args);
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+constexpr size_t max_str_size = (1 << 14);
+
+enum class Compression {
+    none,
+    gzip,
+    zstd
+};
+
+struct Args {
+    FILE *input_file;
+    std::ofstream output_file;
+    std::vector<std::pair<char, const char *>> command_line_arguments;
+    int64_t start_time = 0;
+    int64_t finish_time = LONG_LONG_MAX;
+    int32_t disorder = 60; // на сколько секунд строка может отставать от предыдущих при поиске --from/--to
+    bool sorted = false;   // задан --disorder: лог упорядочен по времени и --from/--to ищутся двоичным поиском
+    int32_t stats_n = 10; // значение по умолчанию
+    int32_t approx_counters = 0; // если не 0, топ -s считается приближённо в стольких счётчиках
+    bool use_mmap = false;
+    int32_t threads = 1;
+    bool streaming = false; // лог читается один раз по мере поступления: stdin или --follow
+    bool follow = false;
+    int32_t report_interval = 10; // секунды между промежуточными результатами в потоковом режиме
+    const char *index_path = nullptr;
+    Compression compression = Compression::none; // сжатый лог распаковывается на лету
+    std::string input_prefix; // начало неперематываемого входа, прочитанное при определении сжатия
+    const char *series_path = nullptr; // CSV с числом запросов по интервалам времени
+    int32_t series_bucket = 60;        // длина интервала в секундах
+    int32_t series_endpoints = 5;      // сколько самых частых адресов выводить отдельными столбцами
+};
+
+struct InfoFromLog {
+    int32_t code;
+    std::string_view request; // срез строки лога, без копирования
+    int64_t time;
+};
+
+struct DateTime {
+    int32_t day;
+    int32_t month;
+    int32_t year;
+    int32_t hour;
+    int32_t minute;
+    int32_t second;
+};
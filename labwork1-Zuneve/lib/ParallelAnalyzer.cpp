@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include "ParallelAnalyzer.h"
+#include "TimeSeek.h"
+
+std::vector<std::string_view> SplitIntoChunks(std::string_view data, int32_t count) {
+    std::vector<std::string_view> chunks;
+    size_t begin = 0;
+    for (int32_t i = 1; i <= count && begin < data.size(); ++i) {
+        size_t end = std::max(data.size() / count * i, begin);
+        end = data.find('\n', end);
+        end = (end == std::string_view::npos || i == count) ? data.size() : end + 1;
+        chunks.push_back(data.substr(begin, end - begin));
+        begin = end;
+    }
+    return chunks;
+}
+
+// Вывод -p кусков в порядке файла. Кусок, все предыдущие которого закончены, пишет сразу,
+// остальные ждут своей очереди, так что в памяти не больше одного неполного буфера на поток.
+class OrderedErrors {
+    BufferedWriter *writer_;
+    std::mutex mutex_;
+    std::condition_variable turn_changed_;
+    size_t current_ = 0;
+
+public:
+    explicit OrderedErrors(BufferedWriter *writer) : writer_(writer) {
+    }
+
+    void Write(size_t chunk, std::string& buffer) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        turn_changed_.wait(lock, [this, chunk] { return current_ == chunk; });
+        writer_->Write(buffer);
+        buffer.clear();
+    }
+
+    void Finish(size_t chunk, std::string& buffer) {
+        Write(chunk, buffer);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++current_;
+        }
+        turn_changed_.notify_all();
+    }
+};
+
+void AnalyzeChunk(std::string_view chunk, size_t index, Args *args, Analysis *partial, OrderedErrors *errors) {
+    constexpr size_t piece_size = 1 << 20;
+    constexpr size_t errors_buffer_limit = 1 << 20;
+    while (!chunk.empty()) {
+        // кусок разбирается частями, между ними накопленный вывод -p уходит в общий поток
+        size_t end = LineStartAtOrAfter(chunk, piece_size);
+        AnalyzeMapped(chunk.substr(0, end), args, partial);
+        chunk.remove_prefix(end);
+        if (partial->print_errors && partial->errors_buffer.size() >= errors_buffer_limit) {
+            errors->Write(index, partial->errors_buffer);
+        }
+    }
+    if (partial->print_errors) {
+        errors->Finish(index, partial->errors_buffer);
+    }
+}
+
+bool AnalyzeLogParallel(Args *args, Analysis *analysis) {
+    MappedFile file;
+    if (!file.Map(args->input_file)) {
+        return false;
+    }
+    std::string_view data = CanSeekTime(args) ? SeekTimeRange(file.Data(), args) : file.Data();
+    std::vector<std::string_view> chunks = SplitIntoChunks(data, args->threads);
+
+    // у каждого потока свои счётчики и гистограмма, общие данные только читаются
+    std::vector<Analysis> partials(chunks.size());
+    for (Analysis& partial: partials) {
+        partial.print_errors = analysis->print_errors;
+        partial.buffer_errors = true;
+        partial.collect_stats = analysis->collect_stats;
+        partial.approximate_stats = analysis->approximate_stats;
+        partial.heavy_hitters = HeavyHitters(args->approx_counters);
+        partial.collect_histogram = analysis->collect_histogram;
+        partial.collect_series = analysis->collect_series;
+        partial.series = TimeSeries(args->series_bucket, args->series_endpoints);
+    }
+    OrderedErrors errors(analysis->errors_writer);
+    std::vector<std::thread> workers;
+    workers.reserve(chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        workers.emplace_back(AnalyzeChunk, chunks[i], i, args, &partials[i], &errors);
+    }
+    for (std::thread& worker: workers) {
+        worker.join();
+    }
+
+    for (Analysis& partial: partials) {
+        analysis->stats.Merge(partial.stats);
+        analysis->heavy_hitters.Merge(partial.heavy_hitters);
+        analysis->histogram.Merge(partial.histogram);
+        analysis->series.Merge(partial.series);
+    }
+    return true;
+}
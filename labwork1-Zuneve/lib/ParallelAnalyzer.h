@@ -0,0 +1,13 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "Analyzer.h"
+
+// Делит данные на count кусков, границы которых выровнены по концам строк.
+std::vector<std::string_view> SplitIntoChunks(std::string_view data, int32_t count);
+
+// Разбирает отображённый в память лог в args->threads потоков и сливает их частичные результаты.
+// Возвращает false, если файл нельзя отобразить в память; тогда ничего не прочитано.
+bool AnalyzeLogParallel(Args *args, Analysis *analysis);
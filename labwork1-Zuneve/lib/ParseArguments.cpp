@@ -0,0 +1,254 @@
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "ParseArguments.h"
+#include "ParseLog.h"
+
+void Error() {
+    std::cout << "ERROR\nUse --help for usage information.\n";
+}
+
+void PrintHelpArg() {
+    std::cout << "Usage: AnalyzeLog [OPTIONS] logs_filename\n"
+            << "Use - as logs_filename to read the log from stdin.\n"
+            << "Logs compressed with gzip or zstd are detected and decompressed on the fly.\n"
+            << "\nOptions:\n"
+            << "  -o path, --output=path   Path to the file where error requests will be logged. If not specified, "
+            "error request analysis is not performed.\n"
+            << "  -p,   --print            Duplicate the error requests output to stdout.\n"
+            << "  -m,   --mmap             Map the log file into memory and parse it in place without copying "
+            "lines.\n"
+            << "  -s n, --stats=n          Show the top n most frequent requests with 5XX status codes. Default n is "
+            "10.\n"
+            << "  -a n, --approx=n         Count the --stats top approximately in n counters, so memory does not grow "
+            "with the number of distinct requests. Each request is printed with the bounds of its true count.\n"
+            << "  -w t, --window=t         Find and display the time window of t seconds with the maximum number of "
+            "requests. Default is 0 (no calculation). May be repeated: -w 10 -w 60 -w 3600.\n"
+            << "  -f t, --from=time        Start analyzing from the specified timestamp. Default is the earliest "
+            "time in the log.\n"
+            << "  -t t, --to=time          Stop analyzing at the specified timestamp. Default is the latest time in "
+            "the log.\n"
+            << "  -d t, --disorder=t       The log is sorted by time, except that lines may lag behind earlier ones "
+            "by up to t seconds: with --from/--to the file is searched by time instead of read in full. Lines that lag "
+            "more are skipped. Without this option the whole log is read.\n"
+            << "  -j n, --threads=n        Split the log into n parts and parse them in parallel. Default is 1.\n"
+            << "  -F,   --follow           Keep reading the log as it grows, like tail -f.\n"
+            << "  -r n, --report=n         In streaming mode (stdin or --follow) append the current results to the "
+            "output file every n seconds. Default is 10, 0 means only at the end.\n"
+            << "  -i path, --index=path    Binary index of the log. Built on the first run, later runs with the same "
+            "log answer --from/--to queries from it without parsing the log.\n"
+            << "  -S path, --series=path   Write a CSV time series of request counts per status class (2XX-5XX) "
+            "and per most frequent endpoint.\n"
+            << "  -b t, --bucket=t         Length of one time series interval in seconds. Default is 60.\n"
+            << "  -E n, --endpoints=n      Number of most frequent endpoints in the time series. Default is 5.\n"
+            << "\nAll options are computed together in a single pass over the log.\n"
+            << "\nExample:\n"
+            << "  AnalyzeLog --stats=2 --window=60 --from=805821284 --to=807117284 access.log\n"
+            << "  AnalyzeLog -w 10 access.log\n"
+            << "  AnalyzeLog -s 2 access.log\n"
+            << "  AnalyzeLog -s 10 --approx=10000 -o result.txt access.log\n"
+            << "  AnalyzeLog --threads=8 -w 60 -o result.txt access.log\n"
+            << "  zcat access.log.gz | AnalyzeLog -w 60 -o result.txt -\n"
+            << "  AnalyzeLog -s 5 -o result.txt access.log.gz\n"
+            << "  AnalyzeLog --series=series.csv --bucket=1 --endpoints=10 access.log\n"
+            << "  AnalyzeLog --index=access.idx --from=805821284 --to=805907684 -s 5 -o result.txt access.log\n";
+}
+
+void PrintHelpLog() {
+    std::cout << "Logs are text args where each line represents a server access event in the following format:\n"
+            << "\n"
+            << "<remote_addr> - - [<local_time>] \"<request>\" <status> <bytes_send>\n"
+            << "\n"
+            << "Value        Description\n"
+            << "remote_addr  The IP address from which the request was sent.\n"
+            << "local_time   The time when the request was received.\n"
+            << "request      The URL of the request.\n"
+            << "status       The server's response status code.\n"
+            << "bytes_send   The number of bytes sent in the response.\n"
+            << "\nExample log lines:\n"
+            << "198.112.92.15 - - [03/Jul/2024:10:50:02 -0400] \"GET /shuttle/countdown/HTTP/1.0\" 200 3985\n"
+            << "198.112.92.15 - - [03/Jul/2024:10:50:04 -0400] \"GET /shuttle/nosuchpath/HTTP/1.0\" 404 144\n";
+}
+
+void PrintHelp() {
+    PrintHelpArg();
+    std::cout << "\n\n\n";
+    PrintHelpLog();
+    exit(0);
+}
+
+bool IndicateOutputPath(const char *output_path, Args *args) {
+    args->output_file.open(output_path);
+    if (!args->output_file) {
+        std::cerr << "Error opening output file!\n";
+        Error();
+        return false;
+    }
+    return true;
+}
+
+bool FindArguments(const std::pair<char, const char *>& formatted_arg, Args *args) {
+    if (formatted_arg.first == 'o') {
+        IndicateOutputPath(formatted_arg.second, args);
+    } else if (formatted_arg.first == 'i') {
+        args->index_path = formatted_arg.second;
+    } else if (formatted_arg.first == 'S') {
+        args->series_path = formatted_arg.second;
+    } else if (formatted_arg.first == 'b') {
+        if (!IsNumber(formatted_arg.second) || std::stoi(formatted_arg.second) == 0) {
+            Error();
+            return false;
+        }
+        args->series_bucket = std::stoi(formatted_arg.second);
+    } else if (formatted_arg.first == 'E') {
+        if (!IsNumber(formatted_arg.second)) {
+            Error();
+            return false;
+        }
+        args->series_endpoints = std::stoi(formatted_arg.second);
+    } else if (formatted_arg.first == 'f') {
+        if (!IsNumber(formatted_arg.second)) {
+            Error();
+            return false;
+        }
+        args->start_time = std::stoll(formatted_arg.second);
+    } else if (formatted_arg.first == 't') {
+        if (!IsNumber(formatted_arg.second)) {
+            Error();
+            return false;
+        }
+        args->finish_time = std::stoll(formatted_arg.second);
+    } else if (formatted_arg.first == 'd') {
+        if (!IsNumber(formatted_arg.second)) {
+            Error();
+            return false;
+        }
+        args->disorder = std::stoi(formatted_arg.second);
+        args->sorted = true;
+    } else if (formatted_arg.first == 's') {
+        if (!IsNumber(formatted_arg.second)) {
+            Error();
+            return false;
+        }
+        args->stats_n = std::stoi(formatted_arg.second);
+    } else if (formatted_arg.first == 'a') {
+        if (!IsNumber(formatted_arg.second)) {
+            Error();
+            return false;
+        }
+        args->approx_counters = std::stoi(formatted_arg.second);
+    } else if (formatted_arg.first == 'j') {
+        if (!IsNumber(formatted_arg.second)) {
+            Error();
+            return false;
+        }
+        args->threads = std::stoi(formatted_arg.second);
+    } else if (formatted_arg.first == 'r') {
+        if (!IsNumber(formatted_arg.second)) {
+            Error();
+            return false;
+        }
+        args->report_interval = std::stoi(formatted_arg.second);
+    }
+    return true;
+}
+
+char LongArgumentKey(const char *argument) {
+    // длинные опции различаются по имени, а не только по первой букве (--threads и --to)
+    const std::pair<const char *, char> long_arguments[] = {
+        {"output", 'o'}, {"print", 'p'}, {"mmap", 'm'}, {"stats", 's'}, {"window", 'w'},
+        {"from", 'f'}, {"to", 't'}, {"threads", 'j'}, {"follow", 'F'},
+        {"report", 'r'}, {"index", 'i'}, {"disorder", 'd'}, {"approx", 'a'}, {"series", 'S'}, {"bucket", 'b'}, {"endpoints", 'E'},
+        {"help", 'h'}
+    };
+    const char *name = argument + 2;
+    size_t name_length = strcspn(name, "=");
+    for (const std::pair<const char *, char>& long_argument: long_arguments) {
+        if (strlen(long_argument.first) == name_length && strncmp(name, long_argument.first, name_length) == 0) {
+            return long_argument.second;
+        }
+    }
+    return name[0];
+}
+
+std::pair<char, char *> TakeLongArgument(char *& argument) {
+    char *pos_equal = strchr(argument, '=');
+    ++pos_equal;
+    char *value = new char[strlen(pos_equal) + 1];
+    strcpy(value, pos_equal);
+    return std::make_pair(LongArgumentKey(argument), value);
+}
+
+void HandleShortArgument(char *argument, int32_t& argument_counter, int32_t argc,
+                         char **argv, Args *args) {
+    std::pair<char, const char *> formatted_arg;
+    if (argument[1] == 'h') {
+        PrintHelp();
+    } else if (argument[1] == 'p') {
+        formatted_arg = std::make_pair('p', nullptr);
+    } else if (argument[1] == 'm') {
+        formatted_arg = std::make_pair('m', nullptr);
+        args->use_mmap = true;
+    } else if (argument[1] == 'F') {
+        formatted_arg = std::make_pair('F', nullptr);
+        args->follow = true;
+        args->streaming = true;
+    } else {
+        if (argument_counter + 1 < argc) {
+            formatted_arg = std::make_pair(argument[1], argv[++argument_counter]);
+        } else {
+            PrintHelp();
+        }
+        FindArguments(formatted_arg, args);
+    }
+
+    args->command_line_arguments.push_back(formatted_arg);
+}
+
+void HandleLongArgument(char *argument, Args *args) {
+    std::pair<char, const char *> formatted_arg;
+
+    char key = LongArgumentKey(argument);
+    if (key == 'h') {
+        PrintHelp();
+    } else if (key == 'p') {
+        formatted_arg = std::make_pair('p', nullptr);
+    } else if (key == 'm') {
+        formatted_arg = std::make_pair('m', nullptr);
+        args->use_mmap = true;
+    } else if (key == 'F') {
+        formatted_arg = std::make_pair('F', nullptr);
+        args->follow = true;
+        args->streaming = true;
+    } else {
+        formatted_arg = TakeLongArgument(argument);
+    }
+
+    FindArguments(formatted_arg, args);
+    args->command_line_arguments.push_back(formatted_arg);
+}
+
+bool ParseArguments(int32_t argc, char **argv, Args *args) {
+    char *argument;
+    int32_t argument_counter = 1;
+
+    while (argument_counter < argc - 1) {
+        argument = argv[argument_counter];
+
+        if (argument[1] != '-') {
+            HandleShortArgument(argument, argument_counter, argc, argv, args);
+        } else {
+            HandleLongArgument(argument, args);
+        }
+
+        ++argument_counter;
+    }
+    return true;
+}
+
+bool NeedsHelp(int32_t argc, char **argv) {
+    return (argc == 2 &&
+        (argv[1][0] == 'h' or
+            argv[1][0] == '-' and argv[1][2] == 'h'));
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "LogStructs.h"
+
+void Error();
+
+void PrintHelp();
+
+bool NeedsHelp(int32_t argc, char **argv);
+
+bool ParseArguments(int32_t argc, char **argv, Args *args);
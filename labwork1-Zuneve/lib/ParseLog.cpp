@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "ParseLog.h"
+#include "TimestampParser.h"
+
+bool ContainsAll(std::string_view str, const char *chars) {
+    size_t len = strlen(chars);
+    for (size_t i = 0; i < len; ++i) {
+        if (str.find(chars[i]) == std::string_view::npos) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool IsStringValid(std::string_view str) {
+    const char *chars_to_find = "[]\"/-";
+    return ContainsAll(str, chars_to_find);
+}
+
+bool IsNumber(const char *s) {
+    return (s != nullptr && strlen(s) > 0)
+           && (strspn(s, "0123456789") == strlen(s));
+}
+
+constexpr size_t max_date_size = 31;
+
+int32_t MonthIndex(const char *month_str) {
+    const char *months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    for (int32_t i = 0; i < 12; ++i) {
+        if (strcmp(month_str, months[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+DateTime ParseDate(const char *date_str) {
+    DateTime dt{};
+    char month_str[4];
+    sscanf(date_str, "%d/%3s/%d:%d:%d:%d", &dt.day, month_str, &dt.year, &dt.hour, &dt.minute, &dt.second);
+    dt.month = MonthIndex(month_str);
+    dt.year -= 1900;
+    return dt;
+}
+
+int64_t DateTimeToTimestamp(const DateTime& dt) {
+    std::tm time_info = {dt.second, dt.minute, dt.hour, dt.day, dt.month, dt.year};
+    return timegm(&time_info);
+}
+
+int64_t ParseDateToTimestamp(const char *date_str) {
+    DateTime dt = ParseDate(date_str);
+    int64_t timestamp = DateTimeToTimestamp(dt);
+    char timezone[6];
+    strncpy(timezone, date_str + 21, 5);
+    timezone[5] = '\0';
+    int32_t hours = atoi(timezone + 1) / 100; // -0400 -> -400
+    int32_t minutes = atoi(timezone + 3); // -0400 -> 00 == 0
+    int64_t sec = hours * 3600 + minutes * 60;
+    return timezone[0] == '+' ? timestamp - sec : timestamp + sec;
+}
+
+int32_t ParseStatus(std::string_view str) {
+    // статус стоит перед последним пробелом: "... 404 144"
+    size_t last_space = str.rfind(' ');
+    if (last_space == std::string_view::npos || last_space < 4) {
+        return 0;
+    }
+    size_t pos = last_space - 4;
+    while (pos < last_space && str[pos] == ' ') {
+        ++pos;
+    }
+    int32_t code = 0;
+    while (pos < last_space && str[pos] >= '0' && str[pos] <= '9') {
+        code = code * 10 + (str[pos++] - '0');
+    }
+    return code;
+}
+
+InfoFromLog MakeInfo(std::string_view str, std::string_view date_view, size_t first_quote, size_t last_quote) {
+    // у каждого потока свой кеш начала суток
+    thread_local TimestampParser timestamp_parser;
+    InfoFromLog info{};
+    if (first_quote != std::string_view::npos && last_quote > first_quote) {
+        info.request = str.substr(first_quote + 1, last_quote - first_quote - 1);
+    }
+    info.code = ParseStatus(str);
+    if (!timestamp_parser.Parse(date_view, info.time)) {
+        // нестандартная запись даты - медленный, но всеядный разбор
+        char date[32] = {};
+        memcpy(date, date_view.data(), date_view.size());
+        info.time = ParseDateToTimestamp(date);
+    }
+    return info;
+}
+
+InfoFromLog GetInfoFromLog(std::string_view str) {
+    //"198.112.92.15 - - [03/Jul/2024:10:50:04 -0400] \"GET /shuttle/nosuchpath/HTTP/1.0\" 404 144
+    size_t date_start = str.find('[');
+    std::string_view date_view;
+    if (date_start != std::string_view::npos) {
+        date_view = str.substr(date_start + 1, max_date_size);
+        date_view = date_view.substr(0, date_view.find(']'));
+    }
+    return MakeInfo(str, date_view, str.find('\"'), str.rfind('\"'));
+}
+
+InfoFromLog GetInfoFromFields(std::string_view str, const LineFields& fields) {
+    std::string_view date_view;
+    if (fields.open_bracket != LineFields::line_npos) {
+        size_t date_size = max_date_size;
+        if (fields.close_bracket != LineFields::line_npos) {
+            date_size = std::min<size_t>(date_size, fields.close_bracket - fields.open_bracket - 1);
+        }
+        date_view = str.substr(fields.open_bracket + 1, date_size);
+    }
+    size_t first_quote = fields.first_quote == LineFields::line_npos ? std::string_view::npos : fields.first_quote;
+    return MakeInfo(str, date_view, first_quote, fields.last_quote);
+}
+
+bool IsTimeCorrect(int64_t current_time, Args *args) {
+    return current_time >= args->start_time && current_time <= args->finish_time;
+}
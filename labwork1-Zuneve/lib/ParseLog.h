@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string_view>
+
+#include "LineScanner.h"
+#include "LogStructs.h"
+
+bool IsStringValid(std::string_view str);
+
+bool IsNumber(const char *s);
+
+int64_t ParseDateToTimestamp(const char *date_str);
+
+InfoFromLog GetInfoFromLog(std::string_view str);
+
+// то же, что GetInfoFromLog, но положение скобок и кавычек уже найдено ScanLines
+InfoFromLog GetInfoFromFields(std::string_view str, const LineFields& fields);
+
+bool IsTimeCorrect(int64_t current_time, Args *args);
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <iterator>
+
+#include "RequestHistogram.h"
+
+void RequestHistogram::Add(int64_t time, int64_t count) {
+    counts_[time] += count;
+}
+
+void RequestHistogram::Merge(const RequestHistogram& other) {
+    for (const std::pair<const int64_t, int64_t>& second: other.counts_) {
+        counts_[second.first] += second.second;
+    }
+}
+
+std::vector<std::pair<int64_t, int64_t>> RequestHistogram::Sorted() const {
+    std::vector<std::pair<int64_t, int64_t>> seconds(counts_.begin(), counts_.end());
+    std::sort(seconds.begin(), seconds.end());
+    return seconds;
+}
+
+MaxWindow FindMaxWindow(const std::vector<std::pair<int64_t, int64_t>>& seconds, int32_t time_in_window) {
+    MaxWindow window;
+    if (time_in_window <= 0) {
+        return window;
+    }
+    int64_t requests = 0;
+    size_t l = 0;
+    for (size_t r = 0; r < seconds.size(); ++r) {
+        requests += seconds[r].second;
+        while (seconds[r].first - seconds[l].first >= time_in_window) {
+            requests -= seconds[l++].second;
+        }
+        if (requests > window.max_requests) {
+            window.max_requests = requests;
+            window.ans_l = seconds[l].first;
+            window.ans_r = seconds[r].first;
+        }
+    }
+    return window;
+}
+
+SlidingWindow::SlidingWindow(int32_t time_in_window) : time_in_window_(time_in_window) {
+}
+
+void SlidingWindow::Add(int64_t time) {
+    if (seconds_.empty() || time > seconds_.back().first) {
+        seconds_.emplace_back(time, 1);
+    } else if (seconds_.back().first - time >= time_in_window_) {
+        return;
+    } else {
+        // строка пришла не по порядку, но её секунда ещё внутри окна
+        auto it = seconds_.end();
+        while (it != seconds_.begin() && std::prev(it)->first > time) {
+            --it;
+        }
+        if (it != seconds_.begin() && std::prev(it)->first == time) {
+            ++std::prev(it)->second;
+        } else {
+            seconds_.emplace(it, time, 1);
+        }
+    }
+    ++requests_;
+    while (seconds_.back().first - seconds_.front().first >= time_in_window_) {
+        requests_ -= seconds_.front().second;
+        seconds_.pop_front();
+    }
+    if (requests_ > max_window_.max_requests) {
+        max_window_.max_requests = requests_;
+        max_window_.ans_l = seconds_.front().first;
+        max_window_.ans_r = seconds_.back().first;
+    }
+}
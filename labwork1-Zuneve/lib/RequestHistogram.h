@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct MaxWindow {
+    int64_t max_requests = 0;
+    int64_t ans_l = 0;
+    int64_t ans_r = 0;
+};
+
+// Количество запросов в каждую секунду лога.
+class RequestHistogram {
+    std::unordered_map<int64_t, int64_t> counts_;
+
+public:
+    void Add(int64_t time, int64_t count = 1);
+
+    void Merge(const RequestHistogram& other);
+
+    // пары (секунда, количество запросов), отсортированные по времени
+    std::vector<std::pair<int64_t, int64_t>> Sorted() const;
+};
+
+// Окно из time_in_window секунд с наибольшим числом запросов:
+// правая граница перебирается по секундам, левая догоняет её, сумма поддерживается на ходу.
+MaxWindow FindMaxWindow(const std::vector<std::pair<int64_t, int64_t>>& seconds, int32_t time_in_window);
+
+// Окно для потокового режима: хранит только секунды, попавшие в последние time_in_window секунд,
+// поэтому память не растёт со временем работы. Строки, опоздавшие дальше левой границы окна, не учитываются.
+class SlidingWindow {
+    int32_t time_in_window_;
+    std::deque<std::pair<int64_t, int64_t>> seconds_;
+    int64_t requests_ = 0;
+    MaxWindow max_window_;
+
+public:
+    explicit SlidingWindow(int32_t time_in_window);
+
+    void Add(int64_t time);
+
+    const MaxWindow& Max() const { return max_window_; }
+};
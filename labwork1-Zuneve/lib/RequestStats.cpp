@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <cstring>
+#include <queue>
+
+#include "RequestStats.h"
+
+std::string_view StringPool::Intern(std::string_view str) {
+    if (str.empty()) {
+        // пустой строке память не нужна, а блоков у нового пула ещё нет
+        return {};
+    }
+    if (str.size() > block_size) {
+        // длинные строки не дробят общий блок и не становятся blocks_.back(), куда пишутся следующие
+        large_blocks_.push_back(std::make_unique<char[]>(str.size()));
+        memcpy(large_blocks_.back().get(), str.data(), str.size());
+        return {large_blocks_.back().get(), str.size()};
+    }
+    if (used_ + str.size() > block_size) {
+        blocks_.push_back(std::make_unique<char[]>(block_size));
+        used_ = 0;
+    }
+    char *place = blocks_.back().get() + used_;
+    memcpy(place, str.data(), str.size());
+    used_ += str.size();
+    return {place, str.size()};
+}
+
+void RequestStats::Add(std::string_view request, int64_t count) {
+    auto it = counts_.find(request);
+    if (it != counts_.end()) {
+        it->second += count;
+        return;
+    }
+    counts_.emplace(pool_.Intern(request), count);
+}
+
+void RequestStats::Merge(const RequestStats& other) {
+    for (const std::pair<const std::string_view, int64_t>& request: other.counts_) {
+        Add(request.first, request.second);
+    }
+}
+
+size_t RequestStats::Size() const {
+    return counts_.size();
+}
+
+bool IsMoreFrequent(const std::pair<std::string_view, int64_t>& a, const std::pair<std::string_view, int64_t>& b) {
+    return a.second > b.second || (a.second == b.second && a.first < b.first);
+}
+
+std::vector<std::pair<std::string_view, int64_t>> RequestStats::Top(size_t n) const {
+    // на вершине кучи - наименее частый из уже отобранных
+    std::priority_queue<std::pair<std::string_view, int64_t>,
+                        std::vector<std::pair<std::string_view, int64_t>>,
+                        decltype(&IsMoreFrequent)> heap(&IsMoreFrequent);
+    if (n == 0) {
+        return {};
+    }
+    for (const std::pair<const std::string_view, int64_t>& request: counts_) {
+        if (heap.size() < n) {
+            heap.emplace(request.first, request.second);
+        } else if (IsMoreFrequent(request, heap.top())) {
+            heap.pop();
+            heap.emplace(request.first, request.second);
+        }
+    }
+    std::vector<std::pair<std::string_view, int64_t>> top;
+    top.reserve(heap.size());
+    while (!heap.empty()) {
+        top.push_back(heap.top());
+        heap.pop();
+    }
+    std::reverse(top.begin(), top.end());
+    return top;
+}
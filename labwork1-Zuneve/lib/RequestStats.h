@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Хранилище строк запросов: каждая уникальная строка копируется один раз в общий блок памяти,
+// выданные string_view действительны, пока жив пул.
+class StringPool {
+    static constexpr size_t block_size = (1 << 16);
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    std::vector<std::unique_ptr<char[]>> large_blocks_; // строки длиннее block_size, по одной на блок
+    size_t used_ = block_size;
+
+public:
+    std::string_view Intern(std::string_view str);
+};
+
+// Счётчики запросов с 5XX: хеш-таблица по тексту запроса, топ выбирается кучей размера n.
+class RequestStats {
+    StringPool pool_;
+    std::unordered_map<std::string_view, int64_t> counts_;
+
+public:
+    void Add(std::string_view request, int64_t count = 1);
+
+    void Merge(const RequestStats& other);
+
+    size_t Size() const;
+
+    // n самых частых запросов по убыванию частоты, при равенстве - по тексту
+    std::vector<std::pair<std::string_view, int64_t>> Top(size_t n) const;
+};
@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <climits>
+
+#include "ParseLog.h"
+#include "TimeSeek.h"
+
+bool HasTimeRange(const Args *args) {
+    return args->start_time > 0 || args->finish_time < LONG_LONG_MAX;
+}
+
+bool CanSeekTime(const Args *args) {
+    return args->sorted && HasTimeRange(args);
+}
+
+size_t LineStartAtOrAfter(std::string_view data, size_t pos) {
+    if (pos == 0 || pos >= data.size()) {
+        return std::min(pos, data.size());
+    }
+    size_t newline = data.find('\n', pos - 1);
+    return newline == std::string_view::npos ? data.size() : newline + 1;
+}
+
+// время первой корректной строки, начиная с line_start; LONG_LONG_MAX, если таких нет
+int64_t FirstTimeFrom(std::string_view data, size_t line_start) {
+    while (line_start < data.size()) {
+        size_t end = data.find('\n', line_start);
+        end = end == std::string_view::npos ? data.size() : end + 1;
+        std::string_view line = data.substr(line_start, end - line_start);
+        if (IsStringValid(line)) {
+            return GetInfoFromLog(line).time;
+        }
+        line_start = end;
+    }
+    return LONG_LONG_MAX;
+}
+
+size_t SeekTime(std::string_view data, int64_t time) {
+    size_t low = 0;
+    size_t high = data.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (FirstTimeFrom(data, LineStartAtOrAfter(data, middle)) < time) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return LineStartAtOrAfter(data, low);
+}
+
+std::string_view SeekTimeRange(std::string_view data, const Args *args) {
+    size_t begin = 0;
+    size_t end = data.size();
+    if (args->start_time > 0) {
+        begin = SeekTime(data, args->start_time - args->disorder);
+    }
+    if (args->finish_time < LONG_LONG_MAX - args->disorder) {
+        // первая строка позже finish_time + disorder: всё, что за ней, опоздало бы сильнее допустимого
+        end = std::max(begin, SeekTime(data, args->finish_time + args->disorder + 1));
+    }
+    return data.substr(begin, end - begin);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "LogStructs.h"
+
+// true, если задан --from или --to
+bool HasTimeRange(const Args *args);
+
+// true, если диапазон --from/--to можно искать по времени: лог объявлен упорядоченным через --disorder.
+// Иначе строки могут быть перемешаны как угодно, и читается весь лог.
+bool CanSeekTime(const Args *args);
+
+// Начало первой строки, начинающейся в позиции pos или дальше.
+size_t LineStartAtOrAfter(std::string_view data, size_t pos);
+
+// Начало первой строки, начиная с которой время не меньше time. Лог считается упорядоченным
+// по времени: поиск двоичный по байтам, после каждого прыжка - до начала следующей строки.
+size_t SeekTime(std::string_view data, int64_t time);
+
+// Часть лога, где могут быть строки из [start_time, finish_time]. Строки, отстающие от
+// предыдущих не больше чем на args->disorder секунд, не теряются.
+std::string_view SeekTimeRange(std::string_view data, const Args *args);
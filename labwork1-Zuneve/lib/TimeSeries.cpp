@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <fstream>
+
+#include "TimeSeries.h"
+
+std::string_view RequestEndpoint(std::string_view request) {
+    size_t begin = request.find(' ');
+    if (begin == std::string_view::npos) {
+        return request;
+    }
+    std::string_view endpoint = request.substr(begin + 1);
+    return endpoint.substr(0, endpoint.find_first_of(" ?"));
+}
+
+TimeSeries::TimeSeries(int32_t bucket_size, size_t top_endpoints)
+    : bucket_size_(bucket_size), candidates_(std::max<size_t>(top_endpoints, 1) * candidates_per_endpoint) {
+}
+
+void TimeSeries::Add(int64_t time, int32_t code, std::string_view request) {
+    // округление вниз и для времени до 1970 года
+    int64_t bucket = time - ((time % bucket_size_) + bucket_size_) % bucket_size_;
+    auto [it, inserted] = statuses_.try_emplace(bucket);
+    if (inserted) {
+        it->second.fill(0);
+    }
+    if (code >= 200 && code < 600) {
+        ++it->second[code / 100 - 2];
+    }
+    std::string_view endpoint = RequestEndpoint(request);
+    size_t candidates = candidates_.Size();
+    std::string evicted;
+    candidates_.Add(endpoint, 1, 0, &evicted);
+    auto counts = endpoint_counts_.find(endpoint);
+    if (counts == endpoint_counts_.end()) {
+        if (candidates_.Size() == candidates) {
+            // новый кандидат занял место вытесненного, интервалы того больше не нужны
+            endpoint_counts_.erase(endpoint_counts_.find(evicted));
+        }
+        counts = endpoint_counts_.emplace(endpoint, std::unordered_map<int64_t, int64_t>()).first;
+    }
+    ++counts->second[bucket];
+}
+
+void TimeSeries::Merge(const TimeSeries& other) {
+    for (const auto& [bucket, counts]: other.statuses_) {
+        auto [it, inserted] = statuses_.try_emplace(bucket, counts);
+        if (!inserted) {
+            for (size_t i = 0; i < status_classes; ++i) {
+                it->second[i] += counts[i];
+            }
+        }
+    }
+    candidates_.Merge(other.candidates_);
+    for (const auto& [endpoint, counts]: other.endpoint_counts_) {
+        if (!candidates_.Contains(endpoint)) {
+            continue;
+        }
+        auto it = endpoint_counts_.find(endpoint);
+        if (it == endpoint_counts_.end()) {
+            it = endpoint_counts_.emplace(endpoint, std::unordered_map<int64_t, int64_t>()).first;
+        }
+        for (const auto& [bucket, count]: counts) {
+            it->second[bucket] += count;
+        }
+    }
+    // интервалы адресов, не оставшихся кандидатами, больше не нужны
+    std::erase_if(endpoint_counts_, [this](const auto& item) {
+        return !candidates_.Contains(item.first);
+    });
+}
+
+bool TimeSeries::WriteCsv(const char *path, size_t top_endpoints) const {
+    std::vector<HeavyHitter> top = candidates_.Top(top_endpoints);
+
+    std::vector<int64_t> buckets;
+    buckets.reserve(statuses_.size());
+    for (const auto& bucket: statuses_) {
+        buckets.push_back(bucket.first);
+    }
+    std::sort(buckets.begin(), buckets.end());
+
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    file << "time,2XX,3XX,4XX,5XX";
+    for (const HeavyHitter& endpoint: top) {
+        // в CSV кавычки внутри поля удваиваются
+        file << ",\"";
+        for (char c: endpoint.request) {
+            file << c;
+            if (c == '"') {
+                file << c;
+            }
+        }
+        file << '"';
+    }
+    file << '\n';
+    for (int64_t bucket: buckets) {
+        file << bucket;
+        for (int64_t count: statuses_.at(bucket)) {
+            file << ',' << count;
+        }
+        for (const HeavyHitter& endpoint: top) {
+            const std::unordered_map<int64_t, int64_t>& counts = endpoint_counts_.find(endpoint.request)->second;
+            auto it = counts.find(bucket);
+            file << ',' << (it == counts.end() ? 0 : it->second);
+        }
+        file << '\n';
+    }
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "HeavyHitters.h"
+
+// Адрес из запроса "GET /path?query HTTP/1.0" - "/path". Запрос без пробелов возвращается целиком.
+std::string_view RequestEndpoint(std::string_view request);
+
+// Число запросов по интервалам времени длиной bucket_size секунд по классам статуса 2XX-5XX
+// и по самым частым адресам. Кандидаты в самые частые выбираются алгоритмом Space-Saving,
+// поинтервальные счётчики есть только у них, так что память не растёт с числом разных адресов.
+// Пока разных адресов не больше числа кандидатов, результат точный; адрес, вытесненный и
+// вернувшийся позже, теряет интервалы, прошедшие до возвращения.
+class TimeSeries {
+    static constexpr size_t status_classes = 4;
+    static constexpr size_t candidates_per_endpoint = 64;
+
+    struct StringHash {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view str) const { return std::hash<std::string_view>()(str); }
+    };
+
+    int32_t bucket_size_;
+    HeavyHitters candidates_;
+    std::unordered_map<int64_t, std::array<int64_t, status_classes>> statuses_;
+    // адрес-кандидат -> число запросов по интервалам
+    std::unordered_map<std::string, std::unordered_map<int64_t, int64_t>, StringHash, std::equal_to<>> endpoint_counts_;
+
+public:
+    explicit TimeSeries(int32_t bucket_size = 60, size_t top_endpoints = 5);
+
+    void Add(int64_t time, int32_t code, std::string_view request);
+
+    void Merge(const TimeSeries& other);
+
+    // CSV: строка на каждый непустой интервал по возрастанию времени,
+    // столбцы - начало интервала, 2XX, 3XX, 4XX, 5XX и top_endpoints самых частых адресов.
+    bool WriteCsv(const char *path, size_t top_endpoints) const;
+};
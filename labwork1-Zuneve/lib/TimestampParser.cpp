@@ -0,0 +1,104 @@
+#include <cstring>
+
+#include "TimestampParser.h"
+
+bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool ParseDigits(const char *str, size_t count, int32_t& value) {
+    value = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (!IsDigit(str[i])) {
+            return false;
+        }
+        value = value * 10 + (str[i] - '0');
+    }
+    return true;
+}
+
+int32_t FastMonthIndex(const char *month) {
+    // месяц однозначно определяется тремя буквами, без перебора strcmp
+    switch (month[0]) {
+        case 'J':
+            if (month[1] == 'a') {
+                return month[2] == 'n' ? 1 : 0;
+            }
+            if (month[1] != 'u') {
+                return 0;
+            }
+            if (month[2] == 'n') {
+                return 6;
+            }
+            return month[2] == 'l' ? 7 : 0;
+        case 'F':
+            return month[1] == 'e' && month[2] == 'b' ? 2 : 0;
+        case 'M':
+            if (month[1] != 'a') {
+                return 0;
+            }
+            if (month[2] == 'r') {
+                return 3;
+            }
+            return month[2] == 'y' ? 5 : 0;
+        case 'A':
+            if (month[1] == 'p') {
+                return month[2] == 'r' ? 4 : 0;
+            }
+            return month[1] == 'u' && month[2] == 'g' ? 8 : 0;
+        case 'S':
+            return month[1] == 'e' && month[2] == 'p' ? 9 : 0;
+        case 'O':
+            return month[1] == 'c' && month[2] == 't' ? 10 : 0;
+        case 'N':
+            return month[1] == 'o' && month[2] == 'v' ? 11 : 0;
+        case 'D':
+            return month[1] == 'e' && month[2] == 'c' ? 12 : 0;
+        default:
+            return 0;
+    }
+}
+
+int64_t DaysFromCivil(int64_t year, int32_t month, int32_t day) {
+    // алгоритм Howard Hinnant: годы считаются с марта, чтобы високосный день был последним
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t year_of_era = year - era * 400;
+    int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+bool TimestampParser::Parse(std::string_view date, int64_t& timestamp) {
+    // 03/Jul/2024:10:50:02 -0400
+    // 0123456789012345678901234
+    if (date.size() < 26 || date[2] != '/' || date[6] != '/' || date[11] != ':' || date[14] != ':'
+        || date[17] != ':' || date[20] != ' ') {
+        return false;
+    }
+    const char *str = date.data();
+    if (!has_cache_ || memcmp(cached_date_, str, date_length) != 0) {
+        int32_t day;
+        int32_t year;
+        int32_t month = FastMonthIndex(str + 3);
+        if (month == 0 || !ParseDigits(str, 2, day) || !ParseDigits(str + 7, 4, year)) {
+            return false;
+        }
+        memcpy(cached_date_, str, date_length);
+        cached_day_start_ = DaysFromCivil(year, month, day) * 86400;
+        has_cache_ = true;
+    }
+    int32_t hour;
+    int32_t minute;
+    int32_t second;
+    int32_t zone_hours;
+    int32_t zone_minutes;
+    if (!ParseDigits(str + 12, 2, hour) || !ParseDigits(str + 15, 2, minute) || !ParseDigits(str + 18, 2, second)
+        || !ParseDigits(str + 22, 2, zone_hours) || !ParseDigits(str + 24, 2, zone_minutes)) {
+        return false;
+    }
+    timestamp = cached_day_start_ + hour * 3600 + minute * 60 + second;
+    int64_t zone = zone_hours * 3600 + zone_minutes * 60;
+    timestamp = str[21] == '+' ? timestamp - zone : timestamp + zone;
+    return true;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// Разбор времени из лога фиксированного формата "03/Jul/2024:10:50:02 -0400" без sscanf и timegm.
+// Начало суток запоминается: соседние строки лога почти всегда относятся к одной дате.
+class TimestampParser {
+    static constexpr size_t date_length = 11; // "03/Jul/2024"
+
+    char cached_date_[date_length] = {};
+    int64_t cached_day_start_ = 0;
+    bool has_cache_ = false;
+
+public:
+    // false, если строка не в ожидаемом формате
+    bool Parse(std::string_view date, int64_t& timestamp);
+};
+
+// Количество дней от 01.01.1970 до заданной даты (month от 1 до 12).
+int64_t DaysFromCivil(int64_t year, int32_t month, int32_t day);
@@ -0,0 +1,156 @@
+#include <lib/CompressedLogReader.h>
+#include <lib/LogReader.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#ifdef ANALYZELOG_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+
+const std::string plain_log = "(host) - - [01/Jul/1995:00:00:01 -0400] \"GET / HTTP/1.0\" 500 0\n"
+                              "host - - [01/Jul/1995:00:00:02 -0400] \"GET /a HTTP/1.0\" 200 0\n"
+                              "tail without newline";
+
+FILE *FileWith(const std::string& data) {
+    FILE *file = tmpfile();
+    fwrite(data.data(), 1, data.size(), file);
+    rewind(file);
+    return file;
+}
+
+// неперематываемый вход, как stdin из pipe; data должна поместиться в буфер pipe
+FILE *PipeWith(const std::string& data) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return nullptr;
+    }
+    if (write(fds[1], data.data(), data.size()) != static_cast<ssize_t>(data.size())) {
+        return nullptr;
+    }
+    close(fds[1]);
+    return fdopen(fds[0], "r");
+}
+
+std::vector<std::string> ReadLines(LogReader& reader) {
+    std::vector<std::string> lines;
+    std::string_view line;
+    while (reader.NextLine(line)) {
+        lines.emplace_back(line);
+    }
+    return lines;
+}
+
+const std::vector<std::string> plain_lines = {
+    "(host) - - [01/Jul/1995:00:00:01 -0400] \"GET / HTTP/1.0\" 500 0\n",
+    "host - - [01/Jul/1995:00:00:02 -0400] \"GET /a HTTP/1.0\" 200 0\n",
+    "tail without newline"};
+
+TEST(CompressionTest, DetectsFullMagic) {
+    const std::pair<std::string, Compression> cases[] = {
+        {"\x1f\x8b\x08\x00", Compression::gzip},
+        {std::string("\x28\xb5\x2f\xfd\x00", 5), Compression::zstd},
+        {"(GET / HTTP/1.0)\n", Compression::none},
+        {"\x1f plain\n", Compression::none},
+        {"(\xb5\x2f", Compression::none},
+        {"", Compression::none},
+    };
+    for (const std::pair<std::string, Compression>& test_case: cases) {
+        std::string prefix;
+        FILE *file = FileWith(test_case.first);
+        ASSERT_EQ(DetectCompression(file, prefix), test_case.second) << test_case.first;
+        // обычный файл перемотан, ничего не отложено
+        ASSERT_TRUE(prefix.empty());
+        ASSERT_EQ(ftell(file), 0);
+        fclose(file);
+    }
+}
+
+TEST(CompressionTest, PlainFileStartingWithParenthesis) {
+    FILE *file = FileWith(plain_log);
+    std::string prefix;
+    ASSERT_EQ(DetectCompression(file, prefix), Compression::none);
+    FileLogReader reader(file, prefix);
+    ASSERT_EQ(ReadLines(reader), plain_lines);
+    fclose(file);
+}
+
+TEST(CompressionTest, PipeKeepsPeekedBytes) {
+    FILE *file = PipeWith(plain_log);
+    ASSERT_NE(file, nullptr);
+    std::string prefix;
+    ASSERT_EQ(DetectCompression(file, prefix), Compression::none);
+    ASSERT_EQ(prefix, "(hos");
+    FileLogReader reader(file, prefix);
+    ASSERT_EQ(ReadLines(reader), plain_lines);
+    fclose(file);
+
+    // перевод строки внутри прочитанных байт
+    file = PipeWith("a\nb\ncd\n");
+    ASSERT_EQ(DetectCompression(file, prefix), Compression::none);
+    FileLogReader short_reader(file, prefix);
+    ASSERT_EQ(ReadLines(short_reader), std::vector<std::string>({"a\n", "b\n", "cd\n"}));
+    fclose(file);
+}
+
+#ifdef ANALYZELOG_HAVE_ZLIB
+std::string Gzip(const std::string& data) {
+    z_stream stream{};
+    // 16 - заголовок gzip
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+    std::string compressed(deflateBound(&stream, data.size()), '\0');
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef *>(compressed.data());
+    stream.avail_out = static_cast<uInt>(compressed.size());
+    deflate(&stream, Z_FINISH);
+    compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+    return compressed;
+}
+
+TEST(CompressionTest, GzipRoundTrip) {
+    std::string log;
+    std::vector<std::string> lines;
+    for (int32_t i = 0; i < 2000; ++i) {
+        lines.push_back("host - - [01/Jul/1995:00:00:01 -0400] \"GET /" + std::to_string(i) + " HTTP/1.0\" 500 0\n");
+        log += lines.back();
+    }
+    std::string compressed = Gzip(log);
+    // два склеенных gzip читаются подряд
+    std::string concatenated = Gzip(log) + Gzip(log);
+    std::vector<std::string> twice = lines;
+    twice.insert(twice.end(), lines.begin(), lines.end());
+
+    for (bool use_pipe: {false, true}) {
+        FILE *file = use_pipe ? PipeWith(compressed) : FileWith(compressed);
+        ASSERT_NE(file, nullptr);
+        std::string prefix;
+        ASSERT_EQ(DetectCompression(file, prefix), Compression::gzip);
+        CompressedLogReader reader(file, Compression::gzip, prefix);
+        ASSERT_EQ(ReadLines(reader), lines) << use_pipe;
+        ASSERT_FALSE(reader.Failed());
+        fclose(file);
+    }
+    FILE *file = FileWith(concatenated);
+    std::string prefix;
+    ASSERT_EQ(DetectCompression(file, prefix), Compression::gzip);
+    CompressedLogReader reader(file, Compression::gzip, prefix);
+    ASSERT_EQ(ReadLines(reader), twice);
+    fclose(file);
+}
+
+TEST(CompressionTest, TruncatedGzipFails) {
+    std::string compressed = Gzip(plain_log);
+    FILE *file = FileWith(compressed.substr(0, compressed.size() / 2));
+    std::string prefix;
+    ASSERT_EQ(DetectCompression(file, prefix), Compression::gzip);
+    CompressedLogReader reader(file, Compression::gzip, prefix);
+    ReadLines(reader);
+    ASSERT_TRUE(reader.Failed());
+    fclose(file);
+}
+#endif
@@ -0,0 +1,157 @@
+#include <lib/Analyzer.h>
+#include <lib/HeavyHitters.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+// Лог из нескольких частых запросов с 5XX на фоне сканера, который ходит по случайным адресам.
+std::vector<std::string> GenerateLog(int32_t hot_requests, int32_t scanner_requests) {
+    std::vector<std::string> lines;
+    for (int32_t i = 0; i < hot_requests; ++i) {
+        for (int32_t j = 0; j < 2000 - 150 * i; ++j) {
+            lines.push_back("host - - [01/Jul/1995:00:00:01 -0400] \"GET /hot/" + std::to_string(i)
+                            + " HTTP/1.0\" 503 0\n");
+        }
+    }
+    std::mt19937 random(239);
+    for (int32_t i = 0; i < scanner_requests; ++i) {
+        lines.push_back("scanner - - [01/Jul/1995:00:00:02 -0400] \"GET /random/" + std::to_string(random())
+                        + " HTTP/1.0\" 500 0\n");
+        lines.push_back("host - - [01/Jul/1995:00:00:03 -0400] \"GET /ok HTTP/1.0\" 200 10\n");
+    }
+    std::shuffle(lines.begin(), lines.end(), random);
+    return lines;
+}
+
+void AnalyzeLines(const std::vector<std::string>& lines, Args *args, Analysis *analysis) {
+    analysis->collect_stats = true;
+    if (args->approx_counters > 0) {
+        analysis->approximate_stats = true;
+        analysis->heavy_hitters = HeavyHitters(args->approx_counters);
+    }
+    for (const std::string& line: lines) {
+        ProcessLine(line, args, analysis);
+    }
+}
+
+TEST(HeavyHittersTest, SmallInputIsExact) {
+    HeavyHitters heavy_hitters(10);
+    for (int32_t i = 0; i < 5; ++i) {
+        for (int32_t j = 0; j <= i; ++j) {
+            heavy_hitters.Add("GET /" + std::to_string(i));
+        }
+    }
+    std::vector<HeavyHitter> top = heavy_hitters.Top(3);
+    ASSERT_EQ(top.size(), 3);
+    ASSERT_EQ(top[0].request, "GET /4");
+    ASSERT_EQ(top[0].count, 5);
+    ASSERT_EQ(top[2].request, "GET /2");
+    ASSERT_EQ(top[2].count, 3);
+    for (const HeavyHitter& hitter: top) {
+        ASSERT_EQ(hitter.error, 0);
+    }
+    ASSERT_EQ(heavy_hitters.MaxError(), 0);
+}
+
+TEST(HeavyHittersTest, MemoryIsBounded) {
+    HeavyHitters heavy_hitters(16);
+    for (int32_t i = 0; i < 10000; ++i) {
+        heavy_hitters.Add("GET /" + std::to_string(i));
+    }
+    ASSERT_EQ(heavy_hitters.Size(), 16);
+    ASSERT_LE(heavy_hitters.MaxError(), 10000 / 16 + 1);
+}
+
+TEST(HeavyHittersTest, MatchesExactTopOnGeneratedLog) {
+    const int32_t n = 10;
+    std::vector<std::string> lines = GenerateLog(n, 50000);
+
+    Args exact_args;
+    Analysis exact;
+    AnalyzeLines(lines, &exact_args, &exact);
+    std::vector<std::pair<std::string_view, int64_t>> expected = exact.stats.Top(n);
+
+    Args approximate_args;
+    approximate_args.approx_counters = 512;
+    Analysis approximate;
+    AnalyzeLines(lines, &approximate_args, &approximate);
+    std::vector<HeavyHitter> top = approximate.heavy_hitters.Top(n);
+
+    ASSERT_EQ(top.size(), expected.size());
+    ASSERT_LT(approximate.heavy_hitters.Size(), exact.stats.Size());
+    for (size_t i = 0; i < top.size(); ++i) {
+        ASSERT_EQ(top[i].request, expected[i].first);
+        ASSERT_LE(top[i].count - top[i].error, expected[i].second);
+        ASSERT_GE(top[i].count, expected[i].second);
+        ASSERT_LE(top[i].error, approximate.heavy_hitters.MaxError());
+    }
+}
+
+TEST(HeavyHittersTest, MergeKeepsBounds) {
+    const int32_t n = 5;
+    std::vector<std::string> lines = GenerateLog(n, 20000);
+    std::vector<std::string> first(lines.begin(), lines.begin() + lines.size() / 2);
+    std::vector<std::string> second(lines.begin() + lines.size() / 2, lines.end());
+    // частый в первой половине и редкий во второй, где его вытесняет сканер
+    const std::string half_line = "host - - [01/Jul/1995:00:00:04 -0400] \"GET /half HTTP/1.0\" 502 0\n";
+    first.insert(first.end(), 700, half_line);
+    second.insert(second.begin(), 3, half_line);
+    lines.insert(lines.end(), 703, half_line);
+
+    Args exact_args;
+    Analysis exact;
+    AnalyzeLines(lines, &exact_args, &exact);
+    std::vector<std::pair<std::string_view, int64_t>> expected = exact.stats.Top(n);
+
+    Args approximate_args;
+    approximate_args.approx_counters = 256;
+    Analysis first_part;
+    Analysis second_part;
+    AnalyzeLines(first, &approximate_args, &first_part);
+    AnalyzeLines(second, &approximate_args, &second_part);
+    first_part.heavy_hitters.Merge(second_part.heavy_hitters);
+    std::vector<HeavyHitter> top = first_part.heavy_hitters.Top(n);
+
+    ASSERT_EQ(top.size(), expected.size());
+    for (size_t i = 0; i < top.size(); ++i) {
+        ASSERT_EQ(top[i].request, expected[i].first);
+        ASSERT_LE(top[i].count - top[i].error, expected[i].second);
+        ASSERT_GE(top[i].count, expected[i].second);
+    }
+    std::unordered_map<std::string_view, int64_t> exact_counts;
+    for (const std::pair<std::string_view, int64_t>& request: exact.stats.Top(exact.stats.Size())) {
+        exact_counts[request.first] = request.second;
+    }
+    bool half_found = false;
+    for (const HeavyHitter& hitter: first_part.heavy_hitters.Top(first_part.heavy_hitters.Size())) {
+        int64_t exact_count = exact_counts[hitter.request];
+        ASSERT_LE(hitter.count - hitter.error, exact_count) << hitter.request;
+        ASSERT_GE(hitter.count, exact_count) << hitter.request;
+        half_found = half_found || hitter.request == "GET /half HTTP/1.0";
+    }
+    ASSERT_TRUE(half_found);
+}
+
+TEST(HeavyHittersTest, MergeCountsEvictedRequest) {
+    // во второй части x вытеснен, но встречался там один раз
+    HeavyHitters first(2);
+    for (int32_t i = 0; i < 5; ++i) {
+        first.Add("x");
+    }
+    HeavyHitters second(2);
+    for (const char *request: {"x", "y", "y", "z", "z"}) {
+        second.Add(request);
+    }
+    first.Merge(second);
+    ASSERT_EQ(first.Size(), 2);
+    for (const HeavyHitter& hitter: first.Top(2)) {
+        int64_t exact_count = hitter.request == "x" ? 6 : 2;
+        ASSERT_LE(hitter.count - hitter.error, exact_count) << hitter.request;
+        ASSERT_GE(hitter.count, exact_count) << hitter.request;
+    }
+    ASSERT_EQ(first.Top(1)[0].request, "x");
+}
@@ -0,0 +1,168 @@
+#include <lib/Analyzer.h>
+#include <lib/LogIndex.h>
+#include <lib/ParseLog.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <sys/time.h>
+#include <unistd.h>
+
+
+// Лог со слегка перемешанным временем, разными (в том числе пустыми) запросами и кодами и битыми строками.
+std::string GenerateIndexedLog() {
+    std::mt19937 random(8);
+    std::string log;
+    for (int32_t i = 0; i < 3000; ++i) {
+        if (i % 97 == 0) {
+            log += "broken line\n";
+        }
+        if (i % 101 == 0) {
+            // пустой запрос
+            log += "host - - [01/Jul/1995:00:00:00 -0400] \"\" 200 0\n";
+        }
+        int32_t second = std::max(0, i / 10 - static_cast<int32_t>(random() % 5));
+        char time[32];
+        snprintf(time, sizeof(time), "%02d:%02d:%02d", second / 3600, second / 60 % 60, second % 60);
+        int32_t code = random() % 3 == 0 ? 500 + static_cast<int32_t>(random() % 4) : 200;
+        log += "host - - [01/Jul/1995:" + std::string(time) + " -0400] \"GET /page/" + std::to_string(random() % 40)
+               + " HTTP/1.0\" " + std::to_string(code) + " 0\n";
+    }
+    return log;
+}
+
+class LogIndexTest : public testing::Test {
+protected:
+    std::string log_path_ = testing::TempDir() + "log_index_test.log";
+    std::string index_path_ = testing::TempDir() + "log_index_test.idx";
+    std::string log_ = GenerateIndexedLog();
+    FILE *log_file_ = nullptr;
+
+    void SetUp() override {
+        FILE *file = fopen(log_path_.c_str(), "w");
+        ASSERT_NE(file, nullptr);
+        fwrite(log_.data(), 1, log_.size(), file);
+        fclose(file);
+        log_file_ = fopen(log_path_.c_str(), "r");
+        ASSERT_NE(log_file_, nullptr);
+
+        // индекс строится тем же проходом, что и в RunAnalysis
+        Args args;
+        Analysis analysis;
+        IndexBuilder builder;
+        analysis.index_builder = &builder;
+        AnalyzeMapped(log_, &args, &analysis);
+        ASSERT_TRUE(builder.Write(index_path_.c_str(), log_file_));
+    }
+
+    void TearDown() override {
+        if (log_file_ != nullptr) {
+            fclose(log_file_);
+        }
+        remove(log_path_.c_str());
+        remove(index_path_.c_str());
+    }
+};
+
+TEST_F(LogIndexTest, ReopenedIndexMatchesLog) {
+    LogIndex index;
+    ASSERT_TRUE(index.Open(index_path_.c_str(), log_file_));
+    ASSERT_EQ(index.Size(), 3030);
+    for (size_t i = 0; i < index.Size(); ++i) {
+        if (i > 0) {
+            ASSERT_LE(index.Time(i - 1), index.Time(i));
+        }
+        // запись указывает на свою строку лога
+        std::string_view line = std::string_view(log_).substr(index.Offset(i));
+        line = line.substr(0, line.find('\n') + 1);
+        ASSERT_TRUE(IsStringValid(line));
+        InfoFromLog info = GetInfoFromLog(line);
+        ASSERT_EQ(index.Time(i), info.time);
+        ASSERT_EQ(index.Status(i), info.code);
+        ASSERT_EQ(index.Request(i), info.request);
+    }
+}
+
+TEST_F(LogIndexTest, TimeRangeQueryMatchesFullParse) {
+    LogIndex index;
+    ASSERT_TRUE(index.Open(index_path_.c_str(), log_file_));
+    int64_t first = index.Time(0);
+    const std::pair<int64_t, int64_t> ranges[] = {
+        {first + 30, first + 120}, {first, first}, {first - 100, first + 1000}, {first + 1000, first + 2000}};
+    for (const std::pair<int64_t, int64_t>& range: ranges) {
+        Args args;
+        args.start_time = range.first;
+        args.finish_time = range.second;
+        args.stats_n = 10;
+        Analysis from_index;
+        from_index.collect_stats = true;
+        from_index.collect_histogram = true;
+        AnalyzeIndex(index, &args, &from_index);
+        Analysis full;
+        full.collect_stats = true;
+        full.collect_histogram = true;
+        AnalyzeMapped(log_, &args, &full);
+
+        ASSERT_EQ(from_index.histogram.Sorted(), full.histogram.Sorted()) << range.first;
+        ASSERT_EQ(from_index.stats.Top(10), full.stats.Top(10)) << range.first;
+        size_t begin = index.LowerBound(range.first);
+        size_t end = index.UpperBound(range.second);
+        int64_t in_range = 0;
+        for (const std::pair<int64_t, int64_t>& second: full.histogram.Sorted()) {
+            in_range += second.second;
+        }
+        ASSERT_EQ(static_cast<int64_t>(end - begin), in_range) << range.first;
+    }
+}
+
+TEST_F(LogIndexTest, RejectsStaleIndex) {
+    LogIndex index;
+    // тот же размер, другое время изменения
+    struct timeval times[2] = {{1000000000, 0}, {1000000000, 0}};
+    ASSERT_EQ(utimes(log_path_.c_str(), times), 0);
+    ASSERT_FALSE(index.Open(index_path_.c_str(), log_file_));
+
+    // лог дописан
+    ASSERT_TRUE(IndexBuilder().Write(index_path_.c_str(), log_file_));
+    FILE *file = fopen(log_path_.c_str(), "a");
+    fputs("host - - [01/Jul/1995:05:00:00 -0400] \"GET / HTTP/1.0\" 500 0\n", file);
+    fclose(file);
+    LogIndex appended;
+    ASSERT_FALSE(appended.Open(index_path_.c_str(), log_file_));
+}
+
+TEST_F(LogIndexTest, RejectsTruncatedIndex) {
+    FILE *file = fopen(index_path_.c_str(), "rb");
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    for (long truncated_size: {size - 1, size / 2, static_cast<long>(sizeof(IndexHeader)) - 1, 0L}) {
+        ASSERT_EQ(truncate(index_path_.c_str(), truncated_size), 0);
+        LogIndex index;
+        ASSERT_FALSE(index.Open(index_path_.c_str(), log_file_)) << truncated_size;
+    }
+    LogIndex missing;
+    ASSERT_FALSE(missing.Open((index_path_ + ".missing").c_str(), log_file_));
+}
+
+TEST_F(LogIndexTest, RejectsWrongMagic) {
+    FILE *file = fopen(index_path_.c_str(), "r+b");
+    fputc('X', file);
+    fclose(file);
+    LogIndex index;
+    ASSERT_FALSE(index.Open(index_path_.c_str(), log_file_));
+}
+
+TEST_F(LogIndexTest, KeepsWideStatus) {
+    // статус не помещается в 16 бит
+    IndexBuilder builder;
+    builder.AddLine("line\n", InfoFromLog{70000, "GET / HTTP/1.0", 0});
+    builder.AddLine("line\n", InfoFromLog{404, "", 1});
+    ASSERT_TRUE(builder.Write(index_path_.c_str(), log_file_));
+    LogIndex index;
+    ASSERT_TRUE(index.Open(index_path_.c_str(), log_file_));
+    ASSERT_EQ(index.Size(), 2);
+    ASSERT_EQ(index.Status(0), 70000);
+    ASSERT_EQ(index.Status(1), 404);
+    ASSERT_EQ(index.Request(1), "");
+}
@@ -0,0 +1,49 @@
+#include <lib/ParallelAnalyzer.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+
+
+TEST(ParallelAnalyzerTest, PrintsErrorsInFileOrder) {
+    // вывода -p у каждого потока больше, чем он копит до записи
+    std::mt19937 random(4);
+    std::string log;
+    for (int32_t i = 0; i < 150000; ++i) {
+        int32_t code = random() % 4 == 0 ? 200 : 500 + static_cast<int32_t>(random() % 4);
+        log += "host - - [01/Jul/1995:00:00:01 -0400] \"GET /page/" + std::to_string(i) + "/"
+               + std::string(random() % 40, 'x') + " HTTP/1.0\" " + std::to_string(code) + " 0\n";
+    }
+    std::string path = testing::TempDir() + "parallel_analyzer_test.log";
+    FILE *file = fopen(path.c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    fwrite(log.data(), 1, log.size(), file);
+    fclose(file);
+
+    std::ostringstream sequential_output;
+    {
+        BufferedWriter writer(sequential_output);
+        Args args;
+        Analysis analysis;
+        analysis.print_errors = true;
+        analysis.errors_writer = &writer;
+        AnalyzeMapped(log, &args, &analysis);
+    }
+    std::ostringstream parallel_output;
+    {
+        BufferedWriter writer(parallel_output);
+        Args args;
+        args.threads = 4;
+        args.input_file = fopen(path.c_str(), "r");
+        ASSERT_NE(args.input_file, nullptr);
+        Analysis analysis;
+        analysis.print_errors = true;
+        analysis.errors_writer = &writer;
+        ASSERT_TRUE(AnalyzeLogParallel(&args, &analysis));
+        fclose(args.input_file);
+    }
+    remove(path.c_str());
+    ASSERT_GT(sequential_output.str().size(), 4u << 20);
+    ASSERT_EQ(parallel_output.str(), sequential_output.str());
+}
@@ -0,0 +1,51 @@
+#include <lib/RequestStats.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+
+TEST(StringPoolTest, LongStringSurvivesLaterInterns) {
+    StringPool pool;
+    std::string first = "GET /first HTTP/1.0";
+    std::string long_request(70000, 'a');
+    std::string_view first_view = pool.Intern(first);
+    std::string_view long_view = pool.Intern(long_request);
+    std::vector<std::string_view> short_views;
+    for (int32_t i = 0; i < 1000; ++i) {
+        short_views.push_back(pool.Intern("GET /" + std::to_string(i)));
+    }
+    ASSERT_EQ(first_view, first);
+    ASSERT_EQ(long_view, long_request);
+    for (int32_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(short_views[i], "GET /" + std::to_string(i));
+    }
+}
+
+TEST(RequestStatsTest, LongRequestKeepsOtherKeys) {
+    RequestStats stats;
+    std::string long_request(70000, 'b');
+    stats.Add("GET /a");
+    stats.Add(long_request);
+    stats.Add("GET /c");
+    stats.Add("GET /c");
+    stats.Add(long_request);
+    std::vector<std::pair<std::string_view, int64_t>> top = stats.Top(3);
+    ASSERT_EQ(top.size(), 3);
+    ASSERT_EQ(top[0].second, 2);
+    ASSERT_EQ(top[1].second, 2);
+    ASSERT_EQ(top[2].first, "GET /a");
+    ASSERT_EQ(stats.Size(), 3);
+}
+
+TEST(RequestStatsTest, EmptyRequest) {
+    // пустой запрос - первая строка нового пула
+    RequestStats stats;
+    stats.Add("");
+    stats.Add("GET /a");
+    stats.Add("");
+    std::vector<std::pair<std::string_view, int64_t>> top = stats.Top(2);
+    ASSERT_EQ(top.size(), 2);
+    ASSERT_EQ(top[0].first, "");
+    ASSERT_EQ(top[0].second, 2);
+    ASSERT_EQ(top[1].first, "GET /a");
+}
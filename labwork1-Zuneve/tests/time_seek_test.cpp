@@ -0,0 +1,111 @@
+#include <lib/ParallelAnalyzer.h>
+#include <lib/ParseArguments.h>
+#include <lib/ParseLog.h>
+#include <lib/TimeSeek.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+
+std::string MakeLine(int32_t second) {
+    return "host - - [01/Jul/1995:00:00:" + std::string(second < 10 ? "0" : "") + std::to_string(second)
+           + " -0400] \"GET / HTTP/1.0\" 200 0\n";
+}
+
+// время первой корректной строки начиная с pos
+int64_t TimeOf(std::string_view data, size_t pos) {
+    std::string_view line = data.substr(pos, data.find('\n', pos) - pos + 1);
+    while (!IsStringValid(line)) {
+        pos += line.size();
+        line = data.substr(pos, data.find('\n', pos) - pos + 1);
+    }
+    return GetInfoFromLog(line).time;
+}
+
+TEST(TimeSeekTest, FindsFirstLineAtOrAfterTime) {
+    std::string log;
+    for (int32_t second = 0; second < 60; second += 2) {
+        log += "broken line\n";
+        log += MakeLine(second);
+    }
+    int64_t zero = TimeOf(log, 0);
+    ASSERT_EQ(SeekTime(log, zero), 0);
+    ASSERT_EQ(TimeOf(log, SeekTime(log, zero + 10)), zero + 10);
+    ASSERT_EQ(TimeOf(log, SeekTime(log, zero + 11)), zero + 12);
+    ASSERT_EQ(SeekTime(log, zero + 100), log.size());
+}
+
+TEST(TimeSeekTest, RangeKeepsLinesWithinDisorder) {
+    std::string log;
+    for (int32_t second = 0; second < 50; ++second) {
+        // каждая пятая строка опаздывает на 3 секунды
+        log += MakeLine(second % 5 == 4 ? second - 3 : second);
+    }
+    int64_t zero = TimeOf(log, 0);
+    Args args;
+    args.start_time = zero + 20;
+    args.finish_time = zero + 30;
+    args.disorder = 3;
+    std::string_view range = SeekTimeRange(log, &args);
+
+    int32_t in_range = 0;
+    for (size_t pos = 0; pos < range.size(); pos = range.find('\n', pos) + 1) {
+        in_range += IsTimeCorrect(TimeOf(range, pos), &args);
+    }
+    int32_t expected = 0;
+    for (size_t pos = 0; pos < log.size(); pos = log.find('\n', pos) + 1) {
+        expected += IsTimeCorrect(TimeOf(log, pos), &args);
+    }
+    ASSERT_EQ(in_range, expected);
+    ASSERT_LT(range.size(), log.size() / 2);
+}
+
+TEST(TimeSeekTest, UnsortedLogIsReadInFull) {
+    // строки перемешаны как угодно: без --disorder диапазон не ищется и ни одна строка не теряется
+    std::vector<int32_t> seconds;
+    for (int32_t i = 0; i < 600; ++i) {
+        seconds.push_back(i % 60);
+    }
+    std::shuffle(seconds.begin(), seconds.end(), std::mt19937(15));
+    std::string log;
+    for (int32_t second: seconds) {
+        log += MakeLine(second);
+    }
+    std::string path = testing::TempDir() + "time_seek_test.log";
+    FILE *file = fopen(path.c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    fwrite(log.data(), 1, log.size(), file);
+    fclose(file);
+
+    int64_t zero = TimeOf(log, log.find(MakeLine(0)));
+    std::string from = "--from=" + std::to_string(zero + 20);
+    std::string to = "--to=" + std::to_string(zero + 30);
+    std::string threads = "--threads=3";
+    char *argv[] = {path.data(), from.data(), to.data(), threads.data(), path.data()};
+    Args args;
+    ASSERT_TRUE(ParseArguments(5, argv, &args));
+    ASSERT_FALSE(CanSeekTime(&args));
+    args.input_file = fopen(path.c_str(), "r");
+    ASSERT_NE(args.input_file, nullptr);
+    Analysis analysis;
+    analysis.collect_histogram = true;
+    ASSERT_TRUE(AnalyzeLogParallel(&args, &analysis));
+    fclose(args.input_file);
+    remove(path.c_str());
+
+    int64_t in_range = 0;
+    for (const std::pair<int64_t, int64_t>& second: analysis.histogram.Sorted()) {
+        in_range += second.second;
+    }
+    ASSERT_EQ(in_range, 11 * 10);
+
+    // с --disorder лог считается упорядоченным
+    std::string disorder = "--disorder=5";
+    char *sorted_argv[] = {path.data(), from.data(), to.data(), disorder.data(), path.data()};
+    Args sorted_args;
+    ASSERT_TRUE(ParseArguments(5, sorted_argv, &sorted_args));
+    ASSERT_TRUE(CanSeekTime(&sorted_args));
+}
@@ -0,0 +1,122 @@
+#include <lib/TimeSeries.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+std::string ReadCsv(const TimeSeries& series, size_t top_endpoints) {
+    std::string path = testing::TempDir() + "time_series_test.csv";
+    EXPECT_TRUE(series.WriteCsv(path.c_str(), top_endpoints));
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    remove(path.c_str());
+    return content.str();
+}
+
+// Несколько частых адресов на фоне сканера: каждый его запрос - новый адрес.
+struct Request {
+    int64_t time;
+    int32_t code;
+    std::string request;
+};
+
+std::vector<Request> GenerateRequests(int32_t scanner_requests) {
+    std::mt19937 random(11);
+    std::vector<Request> requests;
+    for (int32_t i = 0; i < 20000; ++i) {
+        int64_t time = i / 20;
+        if (i % 2 == 0) {
+            requests.push_back({time, 200, "GET /hot/" + std::to_string(random() % 3) + "?q=1 HTTP/1.0"});
+        } else if (i / 2 < scanner_requests) {
+            requests.push_back({time, 404, "GET /scan/" + std::to_string(i) + " HTTP/1.0"});
+        } else {
+            requests.push_back({time, 500, "GET /warm/" + std::to_string(random() % 10) + " HTTP/1.0"});
+        }
+    }
+    return requests;
+}
+
+// CSV, посчитанный напрямую по всем адресам.
+std::string ExactCsv(const std::vector<Request>& requests, int32_t bucket_size, size_t top_endpoints) {
+    std::map<int64_t, std::vector<int64_t>> statuses;
+    std::map<std::string, std::map<int64_t, int64_t>> endpoints;
+    std::map<std::string, int64_t> totals;
+    for (const Request& request: requests) {
+        int64_t bucket = request.time - request.time % bucket_size;
+        statuses[bucket].resize(4);
+        ++statuses[bucket][request.code / 100 - 2];
+        std::string endpoint(RequestEndpoint(request.request));
+        ++endpoints[endpoint][bucket];
+        ++totals[endpoint];
+    }
+    std::vector<std::pair<int64_t, std::string>> top;
+    for (const auto& [endpoint, total]: totals) {
+        top.push_back({-total, endpoint});
+    }
+    std::sort(top.begin(), top.end());
+    top.resize(std::min(top.size(), top_endpoints));
+    std::string csv = "time,2XX,3XX,4XX,5XX";
+    for (const auto& endpoint: top) {
+        csv += ",\"" + endpoint.second + "\"";
+    }
+    csv += '\n';
+    for (const auto& [bucket, counts]: statuses) {
+        csv += std::to_string(bucket);
+        for (int64_t count: counts) {
+            csv += ',' + std::to_string(count);
+        }
+        for (const auto& endpoint: top) {
+            csv += ',' + std::to_string(endpoints[endpoint.second][bucket]);
+        }
+        csv += '\n';
+    }
+    return csv;
+}
+
+TEST(TimeSeriesTest, EmptyRequest) {
+    TimeSeries series(10, 2);
+    series.Add(5, 500, "");
+    series.Add(15, 200, "GET /a HTTP/1.0");
+    series.Add(16, 200, "");
+    ASSERT_EQ(ReadCsv(series, 2), "time,2XX,3XX,4XX,5XX,\"\",\"/a\"\n0,0,0,0,1,1,0\n10,2,0,0,0,1,1\n");
+}
+
+TEST(TimeSeriesTest, ExactWithFewEndpoints) {
+    std::vector<Request> requests = GenerateRequests(0);
+    TimeSeries series(60, 5);
+    for (const Request& request: requests) {
+        series.Add(request.time, request.code, request.request);
+    }
+    ASSERT_EQ(ReadCsv(series, 5), ExactCsv(requests, 60, 5));
+}
+
+TEST(TimeSeriesTest, ScannerDoesNotDisplaceFrequentEndpoints) {
+    // разных адресов намного больше, чем кандидатов, но частые адреса не вытесняются
+    std::vector<Request> requests = GenerateRequests(8000);
+    TimeSeries series(60, 3);
+    for (const Request& request: requests) {
+        series.Add(request.time, request.code, request.request);
+    }
+    ASSERT_EQ(ReadCsv(series, 3), ExactCsv(requests, 60, 3));
+}
+
+TEST(TimeSeriesTest, MergeMatchesSinglePass) {
+    std::vector<Request> requests = GenerateRequests(3000);
+    TimeSeries whole(30, 4);
+    TimeSeries first(30, 4);
+    TimeSeries second(30, 4);
+    for (size_t i = 0; i < requests.size(); ++i) {
+        whole.Add(requests[i].time, requests[i].code, requests[i].request);
+        (i < requests.size() / 3 ? first : second).Add(requests[i].time, requests[i].code, requests[i].request);
+    }
+    first.Merge(second);
+    ASSERT_EQ(ReadCsv(first, 4), ReadCsv(whole, 4));
+    ASSERT_EQ(ReadCsv(first, 4), ExactCsv(requests, 30, 4));
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <lib/number.h>
+
+// Исходная побитовая реализация uint239_t: каждая операция снимает сдвиг по одному биту за раз
+// и складывает/вычитает по одному биту. Нужна только как точка отсчёта для number_bench.
+namespace bitwise {
+
+uint239_t FromInt(uint32_t value, uint32_t shift);
+
+uint239_t FromString(const char* str, uint32_t shift);
+
+uint239_t Add(const uint239_t& lhs, const uint239_t& rhs);
+
+uint239_t Sub(const uint239_t& lhs, const uint239_t& rhs);
+
+uint239_t Mul(const uint239_t& lhs, const uint239_t& rhs);
+
+uint239_t Div(const uint239_t& lhs, const uint239_t& rhs);
+
+bool Equal(const uint239_t& lhs, const uint239_t& rhs);
+
+bool Less(const uint239_t& lhs, const uint239_t& rhs);
+
+std::ostream& Print(std::ostream& stream, const uint239_t& value);
+
+} // namespace bitwise
@@ -0,0 +1,359 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <lib/number.h>
+#include <lib/number_array.h>
+
+#include "bitwise_number.h"
+
+// Время одной операции uint239_t в текущей реализации и в исходной побитовой,
+// на случайных числах со случайными сдвигами. Заодно проверяется, что результаты совпадают.
+// Разбор и вывод сравниваются с переводом по одной цифре, а пакетные ParseNumbers/FormatNumbers
+// меряются на всех числах сразу. Ядра над NumberArray сравниваются с циклом по операторам,
+// а накопление через +=, *= и MulAdd - с накоплением через обычные операторы.
+// Сортировка sort_count чисел через <=> сравнивается с сортировкой по значениям без сдвига.
+//
+// Usage: number_bench [count] [sort_count]
+
+struct Operands {
+    std::vector<uint239_t> lhs;
+    std::vector<uint239_t> rhs;
+};
+
+std::string RandomDecimal(std::mt19937& random, size_t max_digits) {
+    std::string digits(1 + random() % max_digits, '0');
+    for (char& digit: digits) {
+        digit = static_cast<char>('0' + random() % 10);
+    }
+    digits[0] = static_cast<char>('1' + random() % 9);
+    return digits;
+}
+
+Operands MakeOperands(size_t count) {
+    std::mt19937 random(239);
+    Operands operands;
+    for (size_t i = 0; i < count; ++i) {
+        // делитель короче делимого, чтобы частное не было почти всегда нулём
+        operands.lhs.push_back(FromString(RandomDecimal(random, 60).c_str(), random() % 1000));
+        operands.rhs.push_back(FromString(RandomDecimal(random, 30).c_str(), random() % 1000));
+    }
+    return operands;
+}
+
+// Перевод по одной цифре, как было до кусков по 18 цифр: на каждую цифру
+// одно умножение и сложение uint239_t при разборе и одно деление при выводе.
+uint239_t DigitwiseFromString(const std::string& str) {
+    const uint239_t ten = FromInt(10, 0);
+    uint239_t result = FromInt(0, 0);
+    for (char digit: str) {
+        result = result * ten + FromInt(digit - '0', 0);
+    }
+    return result;
+}
+
+std::string DigitwiseToString(uint239_t value) {
+    const uint239_t zero = FromInt(0, 0);
+    const uint239_t ten = FromInt(10, 0);
+    std::string digits;
+    char digit[kMaxDecimalLength];
+    while (value != zero) {
+        uint239_t quotient = value / ten;
+        ToDecimal(value - quotient * ten, digit);
+        digits.push_back(digit[0]);
+        value = quotient;
+    }
+    return std::string(digits.rbegin(), digits.rend());
+}
+
+template<typename Function>
+double MeasureNanoseconds(const Operands& operands, Function function) {
+    uint64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < operands.lhs.size(); ++i) {
+        checksum += function(operands.lhs[i], operands.rhs[i]);
+    }
+    auto finish = std::chrono::steady_clock::now();
+    if (checksum == 42) {
+        std::cout << ""; // не даёт выбросить вычисления
+    }
+    return std::chrono::duration<double, std::nano>(finish - start).count() / operands.lhs.size();
+}
+
+template<typename Function>
+double MeasureEach(size_t count, Function function) {
+    uint64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        checksum += function(i);
+    }
+    auto finish = std::chrono::steady_clock::now();
+    if (checksum == 42) {
+        std::cout << "";
+    }
+    return std::chrono::duration<double, std::nano>(finish - start).count() / count;
+}
+
+void PrintRow(const char *name, double bitwise, double current) {
+    std::cout << name << bitwise << " ns -> " << current << " ns (x" << bitwise / current << ")\n";
+}
+
+bool ResultsMatch(const Operands& operands) {
+    for (size_t i = 0; i < operands.lhs.size(); ++i) {
+        const uint239_t& a = operands.lhs[i];
+        const uint239_t& b = operands.rhs[i];
+        // побитовое деление теряет нули в середине частного, поэтому вывод сверяется
+        // обратным разбором, а не с побитовым выводом
+        std::ostringstream printed;
+        printed << a;
+        if (DigitwiseToString(a) != printed.str() || DigitwiseFromString(printed.str()) != a) {
+            return false;
+        }
+        if (!bitwise::Equal(a + b, bitwise::Add(a, b)) || !bitwise::Equal(a - b, bitwise::Sub(a, b))
+            || !bitwise::Equal(a * b, bitwise::Mul(a, b)) || (a == b) != bitwise::Equal(a, b)
+            || FromString(printed.str().c_str(), 0) != a) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename Function>
+double MeasureOnce(size_t count, Function function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(finish - start).count() / count;
+}
+
+bool BenchArrays(const Operands& operands) {
+    size_t count = operands.lhs.size();
+    NumberArray lhs = MakeArray(operands.lhs.data(), count);
+    NumberArray rhs = MakeArray(operands.rhs.data(), count);
+    NumberArray result;
+    std::vector<uint239_t> expected(count);
+    std::vector<int8_t> order(count);
+    std::unique_ptr<bool[]> equal(new bool[count]);
+    std::cout << "arrays (" << ArrayInstructionSet() << "), per number:\n";
+
+    PrintRow("add:    ", MeasureOnce(count, [&]() {
+                 for (size_t i = 0; i < count; ++i) {
+                     expected[i] = operands.lhs[i] + operands.rhs[i];
+                 }
+             }),
+             MeasureOnce(count, [&]() { AddArrays(lhs, rhs, result); }));
+    for (size_t i = 0; i < count; ++i) {
+        if (memcmp(GetNumber(result, i).data, expected[i].data, sizeof(expected[i].data)) != 0) {
+            return false;
+        }
+    }
+    PrintRow("sub:    ", MeasureOnce(count, [&]() {
+                 for (size_t i = 0; i < count; ++i) {
+                     expected[i] = operands.lhs[i] - operands.rhs[i];
+                 }
+             }),
+             MeasureOnce(count, [&]() { SubArrays(lhs, rhs, result); }));
+    const uint239_t ten = FromInt(10, 0);
+    PrintRow("mul 10: ", MeasureOnce(count, [&]() {
+                 for (size_t i = 0; i < count; ++i) {
+                     expected[i] = operands.lhs[i] * ten;
+                 }
+             }),
+             MeasureOnce(count, [&]() { MulArrayByScalar(lhs, 10, result); }));
+    PrintRow("cmp:    ", MeasureOnce(count, [&]() {
+                 for (size_t i = 0; i < count; ++i) {
+                     order[i] = operands.lhs[i] < operands.rhs[i] ? -1 : (operands.lhs[i] > operands.rhs[i] ? 1 : 0);
+                 }
+             }),
+             MeasureOnce(count, [&]() { CompareArrays(lhs, rhs, order.data()); }));
+    PrintRow("equal:  ", MeasureOnce(count, [&]() {
+                 for (size_t i = 0; i < count; ++i) {
+                     equal[i] = operands.lhs[i] == operands.rhs[i];
+                 }
+             }),
+             MeasureOnce(count, [&]() { EqualArrays(lhs, rhs, equal.get()); }));
+    uint239_t scalar_sum = FromInt(0, 0);
+    uint239_t array_sum;
+    PrintRow("sum:    ", MeasureOnce(count, [&]() {
+                 for (const uint239_t& value: operands.lhs) {
+                     scalar_sum = scalar_sum + value;
+                 }
+             }),
+             MeasureOnce(count, [&]() { array_sum = SumArray(lhs); }));
+    return memcmp(scalar_sum.data, array_sum.data, sizeof(array_sum.data)) == 0;
+}
+
+bool BenchAccumulation(const Operands& operands) {
+    size_t count = operands.lhs.size();
+    std::cout << "accumulation, per number:\n";
+    uint239_t binary = FromInt(0, 0);
+    uint239_t compound = FromInt(0, 0);
+    PrintRow("acc + a:    ", MeasureOnce(count, [&]() {
+                 for (const uint239_t& value: operands.lhs) {
+                     binary = binary + value;
+                 }
+             }),
+             MeasureOnce(count, [&]() {
+                 for (const uint239_t& value: operands.lhs) {
+                     compound += value;
+                 }
+             }));
+    if (memcmp(binary.data, compound.data, sizeof(binary.data)) != 0) {
+        return false;
+    }
+    binary = FromInt(1, 0);
+    compound = FromInt(1, 0);
+    PrintRow("acc * a:    ", MeasureOnce(count, [&]() {
+                 for (const uint239_t& value: operands.rhs) {
+                     binary = binary * value;
+                 }
+             }),
+             MeasureOnce(count, [&]() {
+                 for (const uint239_t& value: operands.rhs) {
+                     compound *= value;
+                 }
+             }));
+    if (memcmp(binary.data, compound.data, sizeof(binary.data)) != 0) {
+        return false;
+    }
+    binary = FromInt(0, 0);
+    compound = FromInt(0, 0);
+    PrintRow("acc + a * b:", MeasureOnce(count, [&]() {
+                 for (size_t i = 0; i < count; ++i) {
+                     binary = binary + operands.lhs[i] * operands.rhs[i];
+                 }
+             }),
+             MeasureOnce(count, [&]() {
+                 for (size_t i = 0; i < count; ++i) {
+                     MulAdd(compound, operands.lhs[i], operands.rhs[i]);
+                 }
+             }));
+    return memcmp(binary.data, compound.data, sizeof(binary.data)) == 0;
+}
+
+bool BenchSort(size_t count, bool same_shift) {
+    std::mt19937 random(2024);
+    std::vector<uint239_t> values;
+    for (size_t i = 0; i < count; ++i) {
+        values.push_back(FromString(RandomDecimal(random, 74).c_str(), same_shift ? 1000 : random()));
+    }
+    std::vector<uint239_t> deshifted = values;
+    std::cout << "sort " << count << (same_shift ? " numbers, same shift:  " : " numbers, random shifts:");
+    PrintRow(" ", MeasureOnce(count, [&]() {
+                 // как раньше: с обоих чисел снимается сдвиг, потом сравниваются значения
+                 std::sort(deshifted.begin(), deshifted.end(), [](const uint239_t& a, const uint239_t& b) {
+                     return limbs::Compare(limbs::ValueOf(a), limbs::ValueOf(b)) < 0;
+                 });
+             }),
+             MeasureOnce(count, [&]() {
+                 std::sort(values.begin(), values.end(), [](const uint239_t& a, const uint239_t& b) {
+                     return (a <=> b) < 0;
+                 });
+             }));
+    for (size_t i = 0; i < count; ++i) {
+        if (values[i] != deshifted[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    size_t count = argc > 1 ? std::stoull(argv[1]) : 2000;
+    Operands operands = MakeOperands(count);
+    if (!ResultsMatch(operands)) {
+        std::cerr << "results differ!\n";
+        return 1;
+    }
+
+    auto first_byte = [](const uint239_t& value) { return static_cast<uint64_t>(value.data[34]); };
+    PrintRow("a + b:  ", MeasureNanoseconds(operands, [&](const uint239_t& a, const uint239_t& b) {
+                 return first_byte(bitwise::Add(a, b));
+             }),
+             MeasureNanoseconds(operands, [&](const uint239_t& a, const uint239_t& b) {
+                 return first_byte(a + b);
+             }));
+    PrintRow("a - b:  ", MeasureNanoseconds(operands, [&](const uint239_t& a, const uint239_t& b) {
+                 return first_byte(bitwise::Sub(a, b));
+             }),
+             MeasureNanoseconds(operands, [&](const uint239_t& a, const uint239_t& b) {
+                 return first_byte(a - b);
+             }));
+    PrintRow("a * b:  ", MeasureNanoseconds(operands, [&](const uint239_t& a, const uint239_t& b) {
+                 return first_byte(bitwise::Mul(a, b));
+             }),
+             MeasureNanoseconds(operands, [&](const uint239_t& a, const uint239_t& b) {
+                 return first_byte(a * b);
+             }));
+    PrintRow("a / b:  ", MeasureNanoseconds(operands, [&](const uint239_t& a, const uint239_t& b) {
+                 return first_byte(bitwise::Div(a, b));
+             }),
+             MeasureNanoseconds(operands, [&](const uint239_t& a, const uint239_t& b) {
+                 return first_byte(a / b);
+             }));
+    PrintRow("a == b: ", MeasureNanoseconds(operands, [&](const uint239_t& a, const uint239_t& b) {
+                 return static_cast<uint64_t>(bitwise::Equal(a, b));
+             }),
+             MeasureNanoseconds(operands, [&](const uint239_t& a, const uint239_t& b) {
+                 return static_cast<uint64_t>(a == b);
+             }));
+
+    std::vector<std::string> decimals;
+    std::string joined;
+    for (const uint239_t& value: operands.lhs) {
+        std::ostringstream printed;
+        printed << value;
+        decimals.push_back(printed.str());
+        joined += printed.str();
+        joined.push_back('\n');
+    }
+    PrintRow("parse:  ", MeasureEach(count, [&](size_t i) {
+                 return static_cast<uint64_t>(DigitwiseFromString(decimals[i]).data[34]);
+             }),
+             MeasureEach(count, [&](size_t i) {
+                 return static_cast<uint64_t>(FromString(decimals[i].c_str(), 0).data[34]);
+             }));
+    char buffer[kMaxDecimalLength];
+    PrintRow("print:  ", MeasureEach(count, [&](size_t i) {
+                 return static_cast<uint64_t>(DigitwiseToString(operands.lhs[i]).size());
+             }),
+             MeasureEach(count, [&](size_t i) {
+                 return static_cast<uint64_t>(ToDecimal(operands.lhs[i], buffer));
+             }));
+
+    std::vector<uint239_t> parsed(count);
+    std::vector<char> formatted(count * (kMaxDecimalLength + 1));
+    auto start = std::chrono::steady_clock::now();
+    size_t parsed_count = ParseNumbers(joined.data(), joined.size(), 0, parsed.data(), count);
+    auto middle = std::chrono::steady_clock::now();
+    size_t length = FormatNumbers(parsed.data(), parsed_count, formatted.data());
+    auto finish = std::chrono::steady_clock::now();
+    if (parsed_count != count || std::string(formatted.data(), length) != joined) {
+        std::cerr << "batch results differ!\n";
+        return 1;
+    }
+    std::cout << "ParseNumbers:  " << std::chrono::duration<double, std::nano>(middle - start).count() / count
+              << " ns per number\n";
+    std::cout << "FormatNumbers: " << std::chrono::duration<double, std::nano>(finish - middle).count() / count
+              << " ns per number\n";
+    if (!BenchArrays(operands)) {
+        std::cerr << "array results differ!\n";
+        return 1;
+    }
+    if (!BenchAccumulation(operands)) {
+        std::cerr << "accumulation results differ!\n";
+        return 1;
+    }
+    size_t sort_count = argc > 2 ? std::stoull(argv[2]) : 1000000;
+    if (!BenchSort(sort_count, true) || !BenchSort(sort_count, false)) {
+        std::cerr << "sort results differ!\n";
+        return 1;
+    }
+    return 0;
+}
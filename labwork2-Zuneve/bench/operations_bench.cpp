@@ -0,0 +1,205 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <lib/number.h>
+
+// Время одной операции uint239_t (ns/op) рядом с той же операцией над unsigned __int128.
+// Наборы входов: small - числа до 2^32 со сдвигом 0, large - до 74 цифр со сдвигом 0,
+// high shift - те же большие числа со сдвигами от 2^31: значение повёрнуто, а сдвиг занимает все 32 младших
+// служебных бита, которые сохраняет FromString; старшие 3 из 35 остаются нулями.
+// __int128 получает те же десятичные записи (большие - по модулю 2^128), так что его время -
+// нижняя граница для встроенного целого той же задачи. Каждый замер повторяется repeats раз,
+// печатается лучший.
+//
+// Usage: operations_bench [count] [repeats]
+
+using uint128_t = unsigned __int128;
+
+struct InputSet {
+    const char* name;
+    std::vector<uint32_t> lhs_int;
+    std::vector<uint32_t> lhs_shift;
+    std::vector<uint32_t> rhs_shift;
+    std::vector<std::string> lhs_decimal;
+    std::vector<uint239_t> lhs;
+    std::vector<uint239_t> rhs;
+    std::vector<uint128_t> lhs_native;
+    std::vector<uint128_t> rhs_native;
+};
+
+std::string RandomDecimal(std::mt19937& random, size_t min_digits, size_t max_digits) {
+    std::string digits(min_digits + random() % (max_digits - min_digits + 1), '0');
+    for (char& digit: digits) {
+        digit = static_cast<char>('0' + random() % 10);
+    }
+    digits[0] = static_cast<char>('1' + random() % 9);
+    return digits;
+}
+
+uint128_t ParseNative(const char* str) {
+    uint128_t value = 0;
+    for (; *str != '\0'; ++str) {
+        value = value * 10 + (*str - '0');
+    }
+    return value;
+}
+
+std::ostream& PrintNative(std::ostream& stream, uint128_t value) {
+    char buffer[39]; // 2^128 - 1 занимает 39 цифр
+    size_t position = sizeof(buffer);
+    do {
+        buffer[--position] = static_cast<char>('0' + static_cast<uint8_t>(value % 10));
+        value /= 10;
+    } while (value != 0);
+    return stream.write(buffer + position, static_cast<std::streamsize>(sizeof(buffer) - position));
+}
+
+std::string NativeDecimal(uint128_t value) {
+    std::ostringstream stream;
+    PrintNative(stream, value);
+    return stream.str();
+}
+
+InputSet MakeInputSet(const char* name, size_t count, size_t lhs_digits, size_t rhs_digits, bool high_shift) {
+    std::mt19937 random(239);
+    InputSet set;
+    set.name = name;
+    for (size_t i = 0; i < count; ++i) {
+        // делитель короче делимого, чтобы частное не было почти всегда нулём
+        std::string lhs = lhs_digits == 0 ? std::to_string(random()) : RandomDecimal(random, lhs_digits - 10, lhs_digits);
+        std::string rhs = rhs_digits == 0 ? std::to_string(1 + (random() >> (random() % 32)))
+                                          : RandomDecimal(random, rhs_digits - 10, rhs_digits);
+        uint32_t lhs_shift = high_shift ? random() | (1u << 31) : 0;
+        uint32_t rhs_shift = high_shift ? random() | (1u << 31) : 0;
+        set.lhs_int.push_back(random());
+        set.lhs_shift.push_back(lhs_shift);
+        set.rhs_shift.push_back(rhs_shift);
+        set.lhs.push_back(FromString(lhs.c_str(), lhs_shift));
+        set.rhs.push_back(FromString(rhs.c_str(), rhs_shift));
+        set.lhs_native.push_back(ParseNative(lhs.c_str()));
+        set.rhs_native.push_back(ParseNative(rhs.c_str()));
+        set.lhs_decimal.push_back(std::move(lhs));
+    }
+    return set;
+}
+
+uint64_t Digest(const uint239_t& value) {
+    return value.data[0] ^ value.data[34];
+}
+
+uint64_t Digest(uint128_t value) {
+    return static_cast<uint64_t>(value) ^ static_cast<uint64_t>(value >> 64);
+}
+
+template<typename Function>
+double BestNanoseconds(size_t count, size_t repeats, Function function) {
+    uint64_t checksum = 0;
+    double best = 0;
+    for (size_t repeat = 0; repeat < repeats; ++repeat) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i) {
+            checksum += function(i);
+        }
+        auto finish = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double, std::nano>(finish - start).count() / count;
+        if (repeat == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    if (checksum == 42) {
+        std::cout << ""; // не даёт выбросить вычисления
+    }
+    return best;
+}
+
+void PrintRow(const char *name, double current, double native) {
+    std::cout << name << current << " ns/op, __int128 " << native << " ns/op (x" << current / native << ")\n";
+}
+
+bool ResultsMatch(const InputSet& set) {
+    // на малых числах все результаты, кроме вычитания с переполнением, совпадают с __int128
+    for (size_t i = 0; i < set.lhs.size(); ++i) {
+        const uint239_t& a = set.lhs[i];
+        const uint239_t& b = set.rhs[i];
+        uint128_t x = set.lhs_native[i];
+        uint128_t y = set.rhs_native[i];
+        std::ostringstream printed;
+        printed << a + b << ' ' << a * b << ' ' << a / b << ' ' << a % b;
+        std::string expected = NativeDecimal(x + y) + ' ' + NativeDecimal(x * y) + ' ' + NativeDecimal(x / y) + ' '
+                               + NativeDecimal(x % y);
+        if (printed.str() != expected || (a < b) != (x < y) || (a == b) != (x == y)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BenchInputSet(const InputSet& set, size_t repeats) {
+    size_t count = set.lhs.size();
+    const std::vector<uint239_t>& lhs = set.lhs;
+    const std::vector<uint239_t>& rhs = set.rhs;
+    const std::vector<uint128_t>& x = set.lhs_native;
+    const std::vector<uint128_t>& y = set.rhs_native;
+    std::cout << set.name << ":\n";
+
+    PrintRow("FromInt:    ", BestNanoseconds(count, repeats, [&](size_t i) {
+                 return Digest(FromInt(set.lhs_int[i], set.lhs_shift[i]));
+             }),
+             BestNanoseconds(count, repeats, [&](size_t i) {
+                 return Digest(static_cast<uint128_t>(set.lhs_int[i]));
+             }));
+    PrintRow("FromString: ", BestNanoseconds(count, repeats, [&](size_t i) {
+                 return Digest(FromString(set.lhs_decimal[i].c_str(), set.lhs_shift[i]));
+             }),
+             BestNanoseconds(count, repeats, [&](size_t i) {
+                 return Digest(ParseNative(set.lhs_decimal[i].c_str()));
+             }));
+    PrintRow("a + b:      ", BestNanoseconds(count, repeats, [&](size_t i) { return Digest(lhs[i] + rhs[i]); }),
+             BestNanoseconds(count, repeats, [&](size_t i) { return Digest(x[i] + y[i]); }));
+    PrintRow("a - b:      ", BestNanoseconds(count, repeats, [&](size_t i) { return Digest(lhs[i] - rhs[i]); }),
+             BestNanoseconds(count, repeats, [&](size_t i) { return Digest(x[i] - y[i]); }));
+    PrintRow("a * b:      ", BestNanoseconds(count, repeats, [&](size_t i) { return Digest(lhs[i] * rhs[i]); }),
+             BestNanoseconds(count, repeats, [&](size_t i) { return Digest(x[i] * y[i]); }));
+    PrintRow("a / b:      ", BestNanoseconds(count, repeats, [&](size_t i) { return Digest(lhs[i] / rhs[i]); }),
+             BestNanoseconds(count, repeats, [&](size_t i) { return Digest(x[i] / y[i]); }));
+    PrintRow("a % b:      ", BestNanoseconds(count, repeats, [&](size_t i) { return Digest(lhs[i] % rhs[i]); }),
+             BestNanoseconds(count, repeats, [&](size_t i) { return Digest(x[i] % y[i]); }));
+    PrintRow("a == b:     ", BestNanoseconds(count, repeats, [&](size_t i) {
+                 return static_cast<uint64_t>(lhs[i] == rhs[i]);
+             }),
+             BestNanoseconds(count, repeats, [&](size_t i) { return static_cast<uint64_t>(x[i] == y[i]); }));
+    PrintRow("a < b:      ", BestNanoseconds(count, repeats, [&](size_t i) {
+                 return static_cast<uint64_t>(lhs[i] < rhs[i]);
+             }),
+             BestNanoseconds(count, repeats, [&](size_t i) { return static_cast<uint64_t>(x[i] < y[i]); }));
+    std::cout << "GetShift:   " << BestNanoseconds(count, repeats, [&](size_t i) { return GetShift(lhs[i]); })
+              << " ns/op\n";
+    std::ostringstream stream;
+    std::ostringstream native_stream;
+    PrintRow("stream <<:  ", BestNanoseconds(count, repeats, [&](size_t i) {
+                 stream << lhs[i];
+                 return static_cast<uint64_t>(1);
+             }),
+             BestNanoseconds(count, repeats, [&](size_t i) {
+                 PrintNative(native_stream, x[i]);
+                 return static_cast<uint64_t>(1);
+             }));
+}
+
+int main(int argc, char **argv) {
+    size_t count = argc > 1 ? std::stoull(argv[1]) : 10000;
+    size_t repeats = argc > 2 ? std::stoull(argv[2]) : 5;
+    InputSet small = MakeInputSet("small", count, 0, 0, false);
+    if (!ResultsMatch(small)) {
+        std::cerr << "results differ!\n";
+        return 1;
+    }
+    BenchInputSet(small, repeats);
+    BenchInputSet(MakeInputSet("large", count, 74, 40, false), repeats);
+    BenchInputSet(MakeInputSet("high shift", count, 74, 40, true), repeats);
+    return 0;
+}
@@ -0,0 +1,336 @@
+#pragma once
+#include <bit>
+#include <cinttypes>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// Арифметика над значением uintN_itmo_t без сдвига, общая для number.h и number_array.cpp.
+// Всё constexpr, поэтому числа и таблицы из них можно считать на этапе компиляции.
+namespace limbs {
+
+// Значимые биты числа вместе с padding (Bits бит, для uint239_t - 245) в 64-битных словах, младшее слово первое.
+// Арифметика идёт по словам, а в байты ITMO Endian число упаковывается только на выходе.
+// Если значение помещается в одно слово, умножение и деление - обычные операции над uint64_t.
+template <size_t Bits>
+struct Limbs {
+    static constexpr size_t kWords = (Bits + 63) / 64;
+    uint64_t word[kWords];
+};
+
+template <size_t Bits>
+constexpr uint64_t kTopWordMask = Bits % 64 == 0 ? ~0ull : (1ull << (Bits % 64)) - 1;
+
+constexpr uint64_t LoadBigEndian(const uint8_t *bytes) {
+    // 8 байт подряд, bytes[0] - старший
+    if (!std::is_constant_evaluated() && std::endian::native == std::endian::little) {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        return __builtin_bswap64(word);
+    }
+    uint64_t result = 0;
+    for (uint8_t i = 0; i < 8; ++i) {
+        result = (result << 8) | bytes[i];
+    }
+    return result;
+}
+
+template <size_t Bits>
+constexpr Limbs<Bits> ShiftLeft(const Limbs<Bits> &value, size_t bits) {
+    constexpr size_t kWords = Limbs<Bits>::kWords;
+    Limbs<Bits> result = {};
+    size_t words = bits / 64;
+    uint8_t rest = bits % 64;
+    for (size_t i = kWords; i-- > words;) {
+        result.word[i] = value.word[i - words] << rest;
+        if (rest != 0 && i > words) {
+            result.word[i] |= value.word[i - words - 1] >> (64 - rest);
+        }
+    }
+
+    return result;
+}
+
+template <size_t Bits>
+constexpr Limbs<Bits> ShiftRight(const Limbs<Bits> &value, size_t bits) {
+    constexpr size_t kWords = Limbs<Bits>::kWords;
+    Limbs<Bits> result = {};
+    size_t words = bits / 64;
+    uint8_t rest = bits % 64;
+    for (size_t i = 0; i + words < kWords; ++i) {
+        result.word[i] = value.word[i + words] >> rest;
+        if (rest != 0 && i + words + 1 < kWords) {
+            result.word[i] |= value.word[i + words + 1] << (64 - rest);
+        }
+    }
+
+    return result;
+}
+
+template <size_t Bits>
+constexpr Limbs<Bits> RotateLeft(const Limbs<Bits> &value, size_t bits) {
+    // циклический сдвиг по кольцу из Bits бит: два сдвига слов вместо bits сдвигов на один бит
+    if (bits == 0) {
+        return value;
+    }
+    Limbs<Bits> high = ShiftLeft(value, bits);
+    Limbs<Bits> low = ShiftRight(value, Bits - bits);
+    Limbs<Bits> result = {};
+    for (size_t i = 0; i < Limbs<Bits>::kWords; ++i) {
+        result.word[i] = high.word[i] | low.word[i];
+    }
+    result.word[Limbs<Bits>::kWords - 1] &= kTopWordMask<Bits>;
+
+    return result;
+}
+
+template <size_t Bits>
+constexpr Limbs<Bits> RotateRight(const Limbs<Bits> &value, size_t bits) {
+    return RotateLeft(value, (Bits - bits) % Bits);
+}
+
+constexpr uint8_t AddWithCarry(uint8_t carry, uint64_t a, uint64_t b, uint64_t &sum) {
+#if defined(__x86_64__)
+    if (!std::is_constant_evaluated()) {
+        unsigned long long result;
+        carry = _addcarry_u64(carry, a, b, &result);
+        sum = result;
+        return carry;
+    }
+#endif
+    // при вычислении на этапе компиляции интринсики недоступны
+    unsigned __int128 result = static_cast<unsigned __int128>(a) + b + carry;
+    sum = static_cast<uint64_t>(result);
+    return static_cast<uint8_t>(result >> 64);
+}
+
+constexpr uint8_t SubWithBorrow(uint8_t borrow, uint64_t a, uint64_t b, uint64_t &difference) {
+#if defined(__x86_64__)
+    if (!std::is_constant_evaluated()) {
+        unsigned long long result;
+        borrow = _subborrow_u64(borrow, a, b, &result);
+        difference = result;
+        return borrow;
+    }
+#endif
+    unsigned __int128 result = static_cast<unsigned __int128>(a) - b - borrow;
+    difference = static_cast<uint64_t>(result);
+    return static_cast<uint8_t>((result >> 64) & 1);
+}
+
+template <size_t Bits>
+constexpr Limbs<Bits> FromWord(uint64_t value) {
+    // одно слово по модулю 2^Bits
+    Limbs<Bits> result = {};
+    result.word[0] = Limbs<Bits>::kWords == 1 ? value & kTopWordMask<Bits> : value;
+    return result;
+}
+
+template <size_t Bits>
+constexpr Limbs<Bits> Add(const Limbs<Bits> &lhs, const Limbs<Bits> &rhs) {
+    // переполнение значимых бит отбрасывается, как и при побитовом сложении
+    constexpr size_t kWords = Limbs<Bits>::kWords;
+    Limbs<Bits> result = {};
+    uint8_t carry = 0;
+    for (size_t i = 0; i < kWords; ++i) {
+        carry = AddWithCarry(carry, lhs.word[i], rhs.word[i], result.word[i]);
+    }
+    result.word[kWords - 1] &= kTopWordMask<Bits>;
+
+    return result;
+}
+
+template <size_t Bits>
+constexpr Limbs<Bits> Sub(const Limbs<Bits> &lhs, const Limbs<Bits> &rhs) {
+    // по модулю 2^Bits
+    constexpr size_t kWords = Limbs<Bits>::kWords;
+    Limbs<Bits> result = {};
+    uint8_t borrow = 0;
+    for (size_t i = 0; i < kWords; ++i) {
+        borrow = SubWithBorrow(borrow, lhs.word[i], rhs.word[i], result.word[i]);
+    }
+    result.word[kWords - 1] &= kTopWordMask<Bits>;
+
+    return result;
+}
+
+template <size_t Bits>
+constexpr Limbs<Bits> Mul(const Limbs<Bits> &lhs, const Limbs<Bits> &rhs) {
+    constexpr size_t kWords = Limbs<Bits>::kWords;
+    if constexpr (kWords == 1) {
+        return {{(lhs.word[0] * rhs.word[0]) & kTopWordMask<Bits>}};
+    }
+    // Comba: произведения слов собираются по столбцам в накопитель из трёх слов,
+    // каждое слово результата записывается один раз. Столбцы старше kWords-го не нужны.
+    Limbs<Bits> result = {};
+    uint64_t low = 0;
+    uint64_t middle = 0;
+    uint64_t high = 0;
+    for (size_t column = 0; column < kWords; ++column) {
+        for (size_t i = 0; i <= column; ++i) {
+            unsigned __int128 product = static_cast<unsigned __int128>(lhs.word[i]) * rhs.word[column - i];
+            uint8_t carry = AddWithCarry(0, low, static_cast<uint64_t>(product), low);
+            carry = AddWithCarry(carry, middle, static_cast<uint64_t>(product >> 64), middle);
+            high += carry;
+        }
+        result.word[column] = low;
+        low = middle;
+        middle = high;
+        high = 0;
+    }
+    result.word[kWords - 1] &= kTopWordMask<Bits>;
+
+    return result;
+}
+
+template <size_t Bits>
+constexpr void MulAddWord(Limbs<Bits> &value, uint64_t factor, uint64_t addend) {
+    constexpr size_t kWords = Limbs<Bits>::kWords;
+    uint64_t carry = addend;
+    for (size_t i = 0; i < kWords; ++i) {
+        unsigned __int128 current = static_cast<unsigned __int128>(value.word[i]) * factor + carry;
+        value.word[i] = static_cast<uint64_t>(current);
+        carry = static_cast<uint64_t>(current >> 64);
+    }
+    value.word[kWords - 1] &= kTopWordMask<Bits>;
+}
+
+template <size_t Bits>
+constexpr uint64_t DivModWord(Limbs<Bits> &value, uint64_t divisor) {
+    // value /= divisor столбиком по словам, возвращает остаток
+    if constexpr (Limbs<Bits>::kWords == 1) {
+        uint64_t rest = value.word[0] % divisor;
+        value.word[0] /= divisor;
+        return rest;
+    }
+    uint64_t rest = 0;
+    for (size_t i = Limbs<Bits>::kWords; i-- > 0;) {
+        unsigned __int128 current = (static_cast<unsigned __int128>(rest) << 64) | value.word[i];
+        value.word[i] = static_cast<uint64_t>(current / divisor);
+        rest = static_cast<uint64_t>(current % divisor);
+    }
+
+    return rest;
+}
+
+template <size_t Bits>
+constexpr int8_t Compare(const Limbs<Bits> &lhs, const Limbs<Bits> &rhs) {
+    for (size_t i = Limbs<Bits>::kWords; i-- > 0;) {
+        if (lhs.word[i] != rhs.word[i]) {
+            return lhs.word[i] < rhs.word[i] ? -1 : 1;
+        }
+    }
+
+    return 0;
+}
+
+template <size_t Bits>
+constexpr bool IsZero(const Limbs<Bits> &value) {
+    uint64_t any = 0;
+    for (size_t i = 0; i < Limbs<Bits>::kWords; ++i) {
+        any |= value.word[i];
+    }
+
+    return any == 0;
+}
+
+template <size_t Bits>
+constexpr size_t SignificantWords(const Limbs<Bits> &value) {
+    size_t words = Limbs<Bits>::kWords;
+    while (words > 0 && value.word[words - 1] == 0) {
+        --words;
+    }
+
+    return words;
+}
+
+template <size_t Bits>
+constexpr void DivMod(Limbs<Bits> lhs, Limbs<Bits> rhs, Limbs<Bits> &quotient, Limbs<Bits> &remainder) {
+    // Алгоритм D Кнута в системе счисления 2^64. Аргументы - копии,
+    // поэтому результат можно писать в тот же объект, что и делимое.
+    constexpr size_t kWords = Limbs<Bits>::kWords;
+    if constexpr (kWords == 1) {
+        quotient = {{lhs.word[0] / rhs.word[0]}};
+        remainder = {{lhs.word[0] % rhs.word[0]}};
+        return;
+    }
+    size_t n = SignificantWords(rhs);
+    size_t m = SignificantWords(lhs);
+    quotient = {};
+    if (Compare(lhs, rhs) < 0) {
+        remainder = lhs;
+        return;
+    }
+    if (n == 1) {
+        quotient = lhs;
+        remainder = FromWord<Bits>(DivModWord(quotient, rhs.word[0]));
+        return;
+    }
+
+    // нормализация: после сдвига старший бит делителя равен 1,
+    // и оценка очередной цифры частного по двум старшим словам ошибается не больше чем на 2
+    uint8_t norm = __builtin_clzll(rhs.word[n - 1]);
+    uint64_t v[kWords] = {};
+    uint64_t u[kWords + 1] = {};
+    for (size_t i = 0; i < n; ++i) {
+        v[i] = rhs.word[i] << norm;
+        if (norm != 0 && i > 0) {
+            v[i] |= rhs.word[i - 1] >> (64 - norm);
+        }
+    }
+    u[m] = norm != 0 ? lhs.word[m - 1] >> (64 - norm) : 0;
+    for (size_t i = 0; i < m; ++i) {
+        u[i] = lhs.word[i] << norm;
+        if (norm != 0 && i > 0) {
+            u[i] |= lhs.word[i - 1] >> (64 - norm);
+        }
+    }
+
+    const unsigned __int128 base = static_cast<unsigned __int128>(1) << 64;
+    for (size_t j = m - n + 1; j-- > 0;) {
+        unsigned __int128 numerator = (static_cast<unsigned __int128>(u[j + n]) << 64) | u[j + n - 1];
+        unsigned __int128 digit = numerator / v[n - 1];
+        unsigned __int128 rest = numerator % v[n - 1];
+        while (digit >= base || digit * v[n - 2] > ((rest << 64) | u[j + n - 2])) {
+            --digit;
+            rest += v[n - 1];
+            if (rest >= base) {
+                break;
+            }
+        }
+
+        // u[j..j+n] -= digit * v
+        uint64_t carry = 0;
+        uint8_t borrow = 0;
+        for (size_t i = 0; i < n; ++i) {
+            unsigned __int128 product = digit * v[i] + carry;
+            carry = static_cast<uint64_t>(product >> 64);
+            borrow = SubWithBorrow(borrow, u[i + j], static_cast<uint64_t>(product), u[i + j]);
+        }
+        borrow = SubWithBorrow(borrow, u[j + n], carry, u[j + n]);
+        if (borrow != 0) {
+            // цифра оказалась на единицу больше - возвращаем делитель обратно
+            --digit;
+            uint8_t add_carry = 0;
+            for (size_t i = 0; i < n; ++i) {
+                add_carry = AddWithCarry(add_carry, u[i + j], v[i], u[i + j]);
+            }
+            u[j + n] += add_carry;
+        }
+        quotient.word[j] = static_cast<uint64_t>(digit);
+    }
+
+    remainder = {};
+    for (size_t i = 0; i < n; ++i) {
+        remainder.word[i] = u[i] >> norm;
+        if (norm != 0) {
+            remainder.word[i] |= u[i + 1] << (64 - norm);
+        }
+    }
+}
+
+} // namespace limbs
@@ -1,30 +1,467 @@
 #pragma once
 #include <cinttypes>
+#include <compare>
+#include <cstddef>
 #include <iostream>
 
+#include "limbs.h"
 
-struct uint239_t {
-    uint8_t data[35];
+
+// Беззнаковое число из Bytes байт в ITMO Endian: в каждом байте 7 бит значения и служебный бит сдвига,
+// data[0] - старший байт. Значение вместе с padding занимает 7 * Bytes бит.
+template <size_t Bytes>
+struct uintN_itmo_t {
+    static_assert(Bytes > 0, "uintN_itmo_t must have at least one byte");
+    static constexpr size_t kValueBits = 7 * Bytes;
+
+    uint8_t data[Bytes];
 };
 
+using uint239_t = uintN_itmo_t<35>;
+
 static_assert(sizeof(uint239_t) == 35, "Size of uint239_t must be no higher than 35 bytes");
 
-uint239_t FromInt(uint32_t value, uint32_t shift);
+// Не меньше длины десятичной записи 2^(7 * Bytes) - 1: log10(2) < 0.30103
+template <size_t Bytes>
+constexpr size_t kMaxDecimalLengthOf = 7 * Bytes * 30103 / 100000 + 1;
+
+// Максимальная длина десятичной записи uint239_t: 2^245 - 1 занимает 74 цифры
+constexpr size_t kMaxDecimalLength = kMaxDecimalLengthOf<35>;
+
+static_assert(kMaxDecimalLength == 74);
+
+// Создание чисел, операторы и GetShift - constexpr, так что константы и таблицы uint239_t
+// можно считать на этапе компиляции. Ввод-вывод и пакетные функции - только во время работы.
+// Всё, кроме пакетных функций, определено для любой ширины uintN_itmo_t.
+
+template <size_t Bytes>
+constexpr uint64_t GetShift(const uintN_itmo_t<Bytes> &value) {
+    // служебный бит data[Bytes - 1] - младший бит сдвига, читаются не больше 64 младших бит.
+    // Старшие биты восьми байт подряд собираются одним умножением: бит байта j (считая с конца) попадает в бит 56 + j.
+    constexpr size_t kShiftBits = Bytes < 64 ? Bytes : 64;
+    uint64_t shift_value = 0;
+#pragma GCC unroll 8
+    for (size_t chunk = 0; chunk < kShiftBits / 8; ++chunk) {
+        uint64_t high_bits = (limbs::LoadBigEndian(value.data + Bytes - 8 - 8 * chunk) >> 7) & 0x0101010101010101ull;
+        shift_value |= ((high_bits * 0x0102040810204080ull) >> 56) << (8 * chunk);
+    }
+    for (size_t bit = kShiftBits / 8 * 8; bit < kShiftBits; ++bit) {
+        shift_value |= static_cast<uint64_t>(value.data[Bytes - 1 - bit] >> 7) << bit;
+    }
+
+    return shift_value;
+}
+
+// Перевод между значением в Limbs и байтами ITMO Endian
+namespace limbs {
+
+constexpr size_t GetStringLength(const char* str) {
+    size_t length = 0;
+    while (str[length] != '\0') {
+        ++length;
+    }
+
+    return length;
+}
+
+constexpr uint64_t CompressGroups(uint64_t bytes) {
+    // 8 байт по 7 значащих бит, старший байт - старшая группа -> 56 бит подряд.
+    // Группы склеиваются попарно: 7 + 7 в 16 битах, 14 + 14 в 32, 28 + 28 в 64.
+    bytes &= 0x7f7f7f7f7f7f7f7full;
+    bytes = (bytes & 0x007f007f007f007full) | ((bytes & 0x7f007f007f007f00ull) >> 1);
+    bytes = (bytes & 0x00003fff00003fffull) | ((bytes & 0x3fff00003fff0000ull) >> 2);
+    return (bytes & 0x000000000fffffffull) | ((bytes & 0x0fffffff00000000ull) >> 4);
+}
+
+template <size_t Bits>
+constexpr void PutBits(Limbs<Bits> &value, size_t position, uint64_t bits) {
+    // bits шириной не больше 56 бит - в value начиная с бита position
+    size_t word = position / 64;
+    uint8_t offset = position % 64;
+    value.word[word] |= bits << offset;
+    if (offset > 8 && word + 1 < Limbs<Bits>::kWords) {
+        value.word[word + 1] |= bits >> (64 - offset);
+    }
+}
+
+template <size_t Bytes>
+constexpr Limbs<7 * Bytes> Unpack(const uintN_itmo_t<Bytes> &value) {
+    // value без сдвига, служебные биты пропускаются: с конца по 8 байт (56 бит) за раз, оставшиеся старшие байты -
+    // по одному. У uint239_t data[27..34] дают биты 0..55, data[19..26] - 56..111, ..., data[0..2] - 224..244
+    constexpr size_t kChunks = Bytes / 8;
+    Limbs<7 * Bytes> result = {};
+#pragma GCC unroll 8
+    for (size_t chunk = 0; chunk < kChunks; ++chunk) {
+        PutBits(result, 56 * chunk, CompressGroups(LoadBigEndian(value.data + Bytes - 8 - 8 * chunk)));
+    }
+    if constexpr (Bytes % 8 != 0) {
+        uint64_t tail = 0;
+        for (size_t byte = 0; byte < Bytes % 8; ++byte) {
+            tail = tail << 7 | (value.data[byte] & 0x7f);
+        }
+        PutBits(result, 56 * kChunks, tail);
+    }
+
+    return result;
+}
+
+template <size_t Bytes>
+constexpr uint32_t StoredShift(uint32_t shift) {
+    // в служебные биты помещаются только младшие min(Bytes, 32) бит сдвига
+    return Bytes < 32 ? shift & ((1u << Bytes) - 1) : shift;
+}
+
+template <size_t Bytes>
+constexpr size_t Rotation(const uintN_itmo_t<Bytes> &value) {
+    // на сколько бит повёрнуто значение в байтах
+    return static_cast<uint32_t>(::GetShift(value)) % (7 * Bytes);
+}
+
+template <size_t Bytes>
+constexpr void StoreNumber(const Limbs<7 * Bytes> &value, uint32_t shift, uintN_itmo_t<Bytes> &result) {
+    // значение без сдвига -> число в ITMO Endian со сдвигом shift, сразу в память result:
+    // в каждом байте 7 бит сдвинутого значения и один бит shift, младший бит shift - в data[Bytes - 1]
+    constexpr size_t kWords = Limbs<7 * Bytes>::kWords;
+    shift = StoredShift<Bytes>(shift);
+    Limbs<7 * Bytes> rotated = RotateLeft(value, shift % (7 * Bytes));
+    unsigned __int128 bits = rotated.word[0];
+    uint8_t filled = 64;
+    size_t word = 1;
+#pragma GCC unroll 35
+    for (size_t group = 0; group < Bytes; ++group) {
+        if (filled < 7 && word < kWords) {
+            bits |= static_cast<unsigned __int128>(rotated.word[word++]) << filled;
+            filled += 64;
+        }
+        uint8_t shift_bit = group < 32 ? (shift >> group) & 1 : 0;
+        result.data[Bytes - 1 - group] = (static_cast<uint8_t>(bits) & 0x7f) | (shift_bit << 7);
+        bits >>= 7;
+        filled -= 7;
+    }
+}
+
+template <size_t Bytes>
+constexpr uintN_itmo_t<Bytes> MakeNumber(const Limbs<7 * Bytes> &value, uint32_t shift) {
+    uintN_itmo_t<Bytes> result = {};
+    StoreNumber(value, shift, result);
+    return result;
+}
+
+template <size_t Bytes>
+constexpr Limbs<7 * Bytes> ValueOf(const uintN_itmo_t<Bytes> &value) {
+    return RotateRight(Unpack(value), Rotation(value));
+}
+
+constexpr uint64_t kChunkBase = 1000000000000000000ull; // 10^18 - столько цифр помещается в одно слово
+constexpr uint8_t kChunkDigits = 18;
+
+template <size_t Bits>
+constexpr Limbs<Bits> ParseDecimal(const char* str, size_t length) {
+    // по 18 цифр за одно умножение на слово; первый кусок короче, чтобы остальные были полными
+    Limbs<Bits> result = {};
+    size_t chunk = length % kChunkDigits == 0 ? kChunkDigits : length % kChunkDigits;
+    size_t position = 0;
+    while (position < length) {
+        uint64_t digits = 0;
+        uint64_t factor = 1;
+        for (size_t end = position + chunk; position < end; ++position) {
+            digits = digits * 10 + (str[position] - '0');
+            factor *= 10;
+        }
+        MulAddWord(result, factor, digits);
+        chunk = kChunkDigits;
+    }
+
+    return result;
+}
+
+// Сообщает о делении на ноль и завершает программу. При вычислении на этапе компиляции
+// деление на ноль до вызова не доходит: выражение просто перестаёт быть константным.
+[[noreturn]] void DivisionByZero();
+
+} // namespace limbs
+
+// FromInt(value, shift) и FromString(str, shift) создают uint239_t, FromInt<Bytes>(...) - число другой ширины
+
+template <size_t Bytes = 35>
+constexpr uintN_itmo_t<Bytes> FromInt(uint32_t value, uint32_t shift) {
+    return limbs::MakeNumber<Bytes>(limbs::FromWord<7 * Bytes>(value), shift);
+}
+
+template <size_t Bytes = 35>
+constexpr uintN_itmo_t<Bytes> FromString(const char* str, uint32_t shift) {
+    return limbs::MakeNumber<Bytes>(limbs::ParseDecimal<7 * Bytes>(str, limbs::GetStringLength(str)), shift);
+}
+
+namespace limbs {
+
+// Сдвиг результата: при сложении и умножении сдвиги складываются, при вычитании и делении вычитаются.
+// Разность и произведение берутся по модулю 2^Bytes (для Bytes >= 64 - по модулю 2^64).
+// Хранятся только младшие 32 бита.
+
+template <size_t Bytes>
+constexpr uint64_t kShiftModulus = Bytes < 64 ? 1ull << Bytes : 0;
+
+template <size_t Bytes>
+constexpr uint64_t SumShift(const uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    return GetShift(lhs) + GetShift(rhs);
+}
+
+template <size_t Bytes>
+constexpr uint64_t DifferenceShift(const uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    uint32_t shift1 = GetShift(lhs);
+    uint32_t shift2 = GetShift(rhs);
+    if (shift1 >= shift2) {
+        return shift1 - shift2;
+    }
+    return kShiftModulus<Bytes> - (shift2 - shift1);
+}
+
+template <size_t Bytes>
+constexpr uint64_t ProductShift(const uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    return (GetShift(lhs) + GetShift(rhs)) & (kShiftModulus<Bytes> - 1);
+}
+
+template <size_t Bytes>
+constexpr Limbs<7 * Bytes> Remainder(const uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs,
+                                     Limbs<7 * Bytes> &quotient) {
+    Limbs<7 * Bytes> divisor = ValueOf(rhs);
+    if (IsZero(divisor)) {
+        DivisionByZero();
+    }
+    Limbs<7 * Bytes> remainder;
+    DivMod(ValueOf(lhs), divisor, quotient, remainder);
+
+    return remainder;
+}
+
+} // namespace limbs
+
+// Составные операторы пишут результат прямо в lhs, без промежуточного числа.
+// rhs может быть тем же объектом, что и lhs.
+
+template <size_t Bytes>
+constexpr uintN_itmo_t<Bytes> &operator+=(uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    uint64_t shift = limbs::SumShift(lhs, rhs);
+    limbs::StoreNumber(limbs::Add(limbs::ValueOf(lhs), limbs::ValueOf(rhs)), shift, lhs);
+    return lhs;
+}
+
+template <size_t Bytes>
+constexpr uintN_itmo_t<Bytes> &operator-=(uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    uint64_t shift = limbs::DifferenceShift(lhs, rhs);
+    limbs::StoreNumber(limbs::Sub(limbs::ValueOf(lhs), limbs::ValueOf(rhs)), shift, lhs);
+    return lhs;
+}
+
+template <size_t Bytes>
+constexpr uintN_itmo_t<Bytes> &operator*=(uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    uint64_t shift = limbs::ProductShift(lhs, rhs);
+    limbs::StoreNumber(limbs::Mul(limbs::ValueOf(lhs), limbs::ValueOf(rhs)), shift, lhs);
+    return lhs;
+}
+
+template <size_t Bytes>
+constexpr uintN_itmo_t<Bytes> &operator/=(uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    uint64_t shift = limbs::DifferenceShift(lhs, rhs);
+    limbs::Limbs<7 * Bytes> quotient;
+    limbs::Remainder(lhs, rhs, quotient);
+    limbs::StoreNumber(quotient, shift, lhs);
+    return lhs;
+}
+
+template <size_t Bytes>
+constexpr uintN_itmo_t<Bytes> &operator%=(uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    //остаток от деления lhs % rhs, без сдвига
+    limbs::Limbs<7 * Bytes> quotient;
+    limbs::StoreNumber(limbs::Remainder(lhs, rhs, quotient), 0, lhs);
+    return lhs;
+}
+
+// accumulator += lhs * rhs за одну распаковку и упаковку accumulator, произведение не упаковывается.
+// Сдвиг такой же, как у accumulator + lhs * rhs.
+template <size_t Bytes>
+constexpr uintN_itmo_t<Bytes> &MulAdd(uintN_itmo_t<Bytes> &accumulator, const uintN_itmo_t<Bytes> &lhs,
+                                      const uintN_itmo_t<Bytes> &rhs) {
+    uint64_t shift = GetShift(accumulator) + limbs::ProductShift(lhs, rhs);
+    limbs::Limbs<7 * Bytes> product = limbs::Mul(limbs::ValueOf(lhs), limbs::ValueOf(rhs));
+    limbs::StoreNumber(limbs::Add(limbs::ValueOf(accumulator), product), shift, accumulator);
+    return accumulator;
+}
+
+template <size_t Bytes>
+constexpr uintN_itmo_t<Bytes> operator+(const uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    uintN_itmo_t<Bytes> result = lhs;
+    result += rhs;
+    return result;
+}
+
+template <size_t Bytes>
+constexpr uintN_itmo_t<Bytes> operator-(const uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    uintN_itmo_t<Bytes> result = lhs;
+    result -= rhs;
+    return result;
+}
+
+template <size_t Bytes>
+constexpr uintN_itmo_t<Bytes> operator*(const uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    uintN_itmo_t<Bytes> result = lhs;
+    result *= rhs;
+    return result;
+}
+
+template <size_t Bytes>
+constexpr uintN_itmo_t<Bytes> operator/(const uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    uintN_itmo_t<Bytes> result = lhs;
+    result /= rhs;
+    return result;
+}
+
+template <size_t Bytes>
+constexpr uintN_itmo_t<Bytes> operator%(const uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    uintN_itmo_t<Bytes> result = lhs;
+    result %= rhs;
+    return result;
+}
+
+namespace limbs {
+
+// Номера бит ниже - позиции в строке из 7 * Bytes бит, как она лежит в числе: бит 0 - младший бит data[Bytes - 1].
+
+constexpr int8_t CompareWords(uint64_t lhs, uint64_t rhs) {
+    if (lhs != rhs) {
+        return lhs < rhs ? -1 : 1;
+    }
+    return 0;
+}
+
+template <size_t Bytes>
+constexpr int8_t CompareBits(const uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs, size_t low, size_t high) {
+    // сравнение бит low..high прямо в байтах ITMO Endian, от старших к младшим.
+    // Крайние байты отрезка маскируются, а целые байты между ними сравниваются по 8 за раз.
+    size_t first = Bytes - 1 - high / 7;
+    size_t last = Bytes - 1 - low / 7;
+    uint8_t first_mask = (2 << (high % 7)) - 1;
+    uint8_t last_mask = 0x7f & ~((1 << (low % 7)) - 1);
+    if (first == last) {
+        return CompareWords(lhs.data[first] & first_mask & last_mask, rhs.data[first] & first_mask & last_mask);
+    }
+    int8_t order = CompareWords(lhs.data[first] & first_mask, rhs.data[first] & first_mask);
+    size_t byte = first + 1;
+    for (; order == 0 && byte + 8 <= last; byte += 8) {
+        const uint64_t value_bits = 0x7f7f7f7f7f7f7f7full;
+        order = CompareWords(LoadBigEndian(lhs.data + byte) & value_bits, LoadBigEndian(rhs.data + byte) & value_bits);
+    }
+    for (; order == 0 && byte < last; ++byte) {
+        order = CompareWords(lhs.data[byte] & 0x7f, rhs.data[byte] & 0x7f);
+    }
+
+    return order != 0 ? order : CompareWords(lhs.data[last] & last_mask, rhs.data[last] & last_mask);
+}
+
+template <size_t Bytes>
+constexpr int8_t CompareNumbers(const uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    // -1, 0 или 1 - сравнение значений без сдвига
+    size_t rotation = Rotation(lhs);
+    size_t rhs_rotation = Rotation(rhs);
+    if (rotation == rhs_rotation) {
+        // строки повёрнуты одинаково - сравниваем байты, не распаковывая и не поворачивая
+        if (rotation == 0) {
+            return CompareBits(lhs, rhs, 0, 7 * Bytes - 1);
+        }
+        int8_t order = CompareBits(lhs, rhs, 0, rotation - 1);
+        return order != 0 ? order : CompareBits(lhs, rhs, rotation, 7 * Bytes - 1);
+    }
+    // иначе с обоих снимается уже известный поворот
+    return Compare(RotateRight(Unpack(lhs), rotation), RotateRight(Unpack(rhs), rhs_rotation));
+}
+
+} // namespace limbs
+
+// Числа с одинаковым значением, но разными сдвигами равны по == и <=>, хотя их байты различаются,
+// поэтому порядок weak_ordering, а не strong_ordering.
+template <size_t Bytes>
+constexpr std::weak_ordering operator<=>(const uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    return limbs::CompareNumbers(lhs, rhs) <=> 0;
+}
+
+template <size_t Bytes>
+constexpr bool operator==(const uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    return limbs::CompareNumbers(lhs, rhs) == 0;
+}
+
+template <size_t Bytes>
+constexpr bool operator!=(const uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    return limbs::CompareNumbers(lhs, rhs) != 0;
+}
+
+template <size_t Bytes>
+constexpr bool operator<(const uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    // lhs < rhs
+    return limbs::CompareNumbers(lhs, rhs) < 0;
+}
+
+template <size_t Bytes>
+constexpr bool operator>(const uintN_itmo_t<Bytes> &lhs, const uintN_itmo_t<Bytes> &rhs) {
+    // lhs > rhs
+    return limbs::CompareNumbers(lhs, rhs) > 0;
+}
 
-uint239_t FromString(const char* str, uint32_t shift);
+namespace limbs {
 
-uint239_t operator+(const uint239_t& lhs, const uint239_t& rhs);
+template <size_t Bits>
+size_t WriteDecimal(Limbs<Bits> value, char* buffer) {
+    // по 18 цифр за одно деление на 10^18, младшие куски получаются первыми
+    uint64_t chunks[(Bits * 30103 / 100000 + 1) / kChunkDigits + 1];
+    size_t count = 0;
+    do {
+        chunks[count++] = DivModWord(value, kChunkBase);
+    } while (!IsZero(value));
 
-uint239_t operator-(const uint239_t& lhs, const uint239_t& rhs);
+    // старший кусок без ведущих нулей, остальные ровно по 18 цифр
+    char top[kChunkDigits];
+    uint8_t top_length = 0;
+    uint64_t chunk = chunks[count - 1];
+    do {
+        top[top_length++] = static_cast<char>('0' + chunk % 10);
+        chunk /= 10;
+    } while (chunk != 0);
+    size_t length = 0;
+    while (top_length > 0) {
+        buffer[length++] = top[--top_length];
+    }
+    for (size_t i = count - 1; i-- > 0;) {
+        chunk = chunks[i];
+        for (int8_t digit = kChunkDigits - 1; digit >= 0; --digit) {
+            buffer[length + digit] = static_cast<char>('0' + chunk % 10);
+            chunk /= 10;
+        }
+        length += kChunkDigits;
+    }
 
-uint239_t operator*(const uint239_t& lhs, const uint239_t& rhs);
+    return length;
+}
 
-uint239_t operator/(const uint239_t& lhs, const uint239_t& rhs);
+} // namespace limbs
 
-bool operator==(const uint239_t& lhs, const uint239_t& rhs);
+// Десятичная запись value без '\0' в конце, в buffer должно быть не меньше kMaxDecimalLengthOf<Bytes> байт
+// (kMaxDecimalLength для uint239_t). Возвращает длину записи.
+template <size_t Bytes>
+size_t ToDecimal(const uintN_itmo_t<Bytes>& value, char* buffer) {
+    return limbs::WriteDecimal(limbs::ValueOf(value), buffer);
+}
 
-bool operator!=(const uint239_t& lhs, const uint239_t& rhs);
+template <size_t Bytes>
+std::ostream& operator<<(std::ostream& stream, const uintN_itmo_t<Bytes>& value) {
+    char buffer[kMaxDecimalLengthOf<Bytes>];
+    stream.write(buffer, static_cast<std::streamsize>(ToDecimal(value, buffer)));
+    return stream;
+}
 
-std::ostream& operator<<(std::ostream& stream, const uint239_t& value);
+// Разбирает до max_count чисел из buffer, разделённых любыми нецифровыми символами, все со сдвигом shift.
+// Возвращает количество разобранных чисел.
+size_t ParseNumbers(const char* buffer, size_t size, uint32_t shift, uint239_t* result, size_t max_count);
 
-uint64_t GetShift(const uint239_t& value);
\ No newline at end of file
+// Записывает count чисел, каждое с '\n' в конце; в buffer должно быть count * (kMaxDecimalLength + 1) байт.
+// Возвращает длину записи.
+size_t FormatNumbers(const uint239_t* values, size_t count, char* buffer);
@@ -0,0 +1,331 @@
+#include "number_array.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+using namespace limbs;
+
+// значение uint239_t без сдвига - четыре слова, по одному из каждого word[k]
+using ArrayLimbs = Limbs<uint239_t::kValueBits>;
+
+void ResizeArray(NumberArray& array, size_t size) {
+    for (std::vector<uint64_t>& word: array.word) {
+        word.resize(size);
+    }
+    array.shift.resize(size);
+}
+
+ArrayLimbs LoadLimbs(const NumberArray& array, size_t index) {
+    return {{array.word[0][index], array.word[1][index], array.word[2][index], array.word[3][index]}};
+}
+
+void StoreLimbs(NumberArray& array, size_t index, const ArrayLimbs& value) {
+    for (uint8_t k = 0; k < 4; ++k) {
+        array.word[k][index] = value.word[k];
+    }
+}
+
+NumberArray MakeArray(const uint239_t* values, size_t count) {
+    NumberArray array;
+    ResizeArray(array, count);
+    for (size_t i = 0; i < count; ++i) {
+        StoreLimbs(array, i, ValueOf(values[i]));
+        array.shift[i] = GetShift(values[i]);
+    }
+
+    return array;
+}
+
+size_t ArraySize(const NumberArray& array) {
+    return array.shift.size();
+}
+
+uint239_t GetNumber(const NumberArray& array, size_t index) {
+    return MakeNumber<sizeof(uint239_t)>(LoadLimbs(array, index), array.shift[index]);
+}
+
+bool force_scalar_arrays = false;
+
+void ForceScalarArrays(bool force) {
+    force_scalar_arrays = force;
+}
+
+bool UseAvx2() {
+#if defined(__x86_64__)
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2 && !force_scalar_arrays;
+#else
+    return false;
+#endif
+}
+
+const char* ArrayInstructionSet() {
+    return UseAvx2() ? "AVX2" : "scalar";
+}
+
+#if defined(__x86_64__)
+// Каждая функция обрабатывает числа четвёрками с начала массива и возвращает,
+// сколько обработала; остаток (меньше 4 чисел) досчитывается по одному.
+
+__attribute__((target("avx2"))) __m256i Load(const std::vector<uint64_t>& word, size_t index) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(word.data() + index));
+}
+
+__attribute__((target("avx2"))) void Store(std::vector<uint64_t>& word, size_t index, __m256i value) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(word.data() + index), value);
+}
+
+__attribute__((target("avx2"))) __m256i LessUnsigned(__m256i lhs, __m256i rhs) {
+    // в AVX2 есть только знаковое сравнение 64-битных чисел, поэтому знаковый бит переворачивается
+    const __m256i sign = _mm256_set1_epi64x(static_cast<int64_t>(1ull << 63));
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(rhs, sign), _mm256_xor_si256(lhs, sign));
+}
+
+__attribute__((target("avx2"))) size_t Avx2Add(const NumberArray& lhs, const NumberArray& rhs,
+                                                NumberArray& result, size_t size) {
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    const __m256i top_mask = _mm256_set1_epi64x(static_cast<int64_t>(kTopWordMask<uint239_t::kValueBits>));
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        __m256i carry = _mm256_setzero_si256(); // 0 или -1 в каждой дорожке
+        for (uint8_t k = 0; k < 4; ++k) {
+            __m256i a = Load(lhs.word[k], i);
+            __m256i sum = _mm256_add_epi64(a, Load(rhs.word[k], i));
+            // перенос дальше: переполнение a + b или перенос в слово из одних единиц
+            __m256i carry_out = _mm256_or_si256(LessUnsigned(sum, a),
+                                                _mm256_and_si256(carry, _mm256_cmpeq_epi64(sum, ones)));
+            sum = _mm256_sub_epi64(sum, carry);
+            if (k == 3) {
+                sum = _mm256_and_si256(sum, top_mask);
+            }
+            Store(result.word[k], i, sum);
+            carry = carry_out;
+        }
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2"))) size_t Avx2Sub(const NumberArray& lhs, const NumberArray& rhs,
+                                                NumberArray& result, size_t size) {
+    const __m256i top_mask = _mm256_set1_epi64x(static_cast<int64_t>(kTopWordMask<uint239_t::kValueBits>));
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        __m256i borrow = _mm256_setzero_si256(); // 0 или -1 в каждой дорожке
+        for (uint8_t k = 0; k < 4; ++k) {
+            __m256i a = Load(lhs.word[k], i);
+            __m256i b = Load(rhs.word[k], i);
+            __m256i difference = _mm256_sub_epi64(a, b);
+            // заём дальше: a < b или заём из нулевой разности
+            __m256i borrow_out = _mm256_or_si256(
+                LessUnsigned(a, b), _mm256_and_si256(borrow, _mm256_cmpeq_epi64(difference, _mm256_setzero_si256())));
+            difference = _mm256_add_epi64(difference, borrow);
+            if (k == 3) {
+                difference = _mm256_and_si256(difference, top_mask);
+            }
+            Store(result.word[k], i, difference);
+            borrow = borrow_out;
+        }
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2"))) size_t Avx2MulByScalar(const NumberArray& values, uint32_t factor,
+                                                        NumberArray& result, size_t size) {
+    // _mm256_mul_epu32 умножает только младшие 32 бита дорожек, поэтому каждое слово
+    // умножается двумя половинами, а перенос между ними меньше 2^32
+    const __m256i multiplier = _mm256_set1_epi64x(factor);
+    const __m256i low_half = _mm256_set1_epi64x(0xffffffff);
+    const __m256i top_mask = _mm256_set1_epi64x(static_cast<int64_t>(kTopWordMask<uint239_t::kValueBits>));
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        __m256i carry = _mm256_setzero_si256();
+        for (uint8_t k = 0; k < 4; ++k) {
+            __m256i word = Load(values.word[k], i);
+            __m256i low = _mm256_add_epi64(_mm256_mul_epu32(word, multiplier), carry);
+            __m256i high = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(word, 32), multiplier),
+                                            _mm256_srli_epi64(low, 32));
+            carry = _mm256_srli_epi64(high, 32);
+            word = _mm256_or_si256(_mm256_and_si256(low, low_half), _mm256_slli_epi64(high, 32));
+            if (k == 3) {
+                word = _mm256_and_si256(word, top_mask);
+            }
+            Store(result.word[k], i, word);
+        }
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2"))) size_t Avx2Compare(const NumberArray& lhs, const NumberArray& rhs,
+                                                    int8_t* result, size_t size) {
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        // решает старшее из различающихся слов
+        __m256i less = _mm256_setzero_si256();
+        __m256i greater = _mm256_setzero_si256();
+        for (int8_t k = 3; k >= 0; --k) {
+            __m256i a = Load(lhs.word[k], i);
+            __m256i b = Load(rhs.word[k], i);
+            __m256i undecided = _mm256_cmpeq_epi64(less, greater);
+            less = _mm256_or_si256(less, _mm256_and_si256(undecided, LessUnsigned(a, b)));
+            greater = _mm256_or_si256(greater, _mm256_and_si256(undecided, LessUnsigned(b, a)));
+        }
+        int less_bits = _mm256_movemask_pd(_mm256_castsi256_pd(less));
+        int greater_bits = _mm256_movemask_pd(_mm256_castsi256_pd(greater));
+        for (uint8_t lane = 0; lane < 4; ++lane) {
+            result[i + lane] = static_cast<int8_t>(((greater_bits >> lane) & 1) - ((less_bits >> lane) & 1));
+        }
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2"))) size_t Avx2Equal(const NumberArray& lhs, const NumberArray& rhs,
+                                                  bool* result, size_t size) {
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        __m256i difference = _mm256_setzero_si256();
+        for (uint8_t k = 0; k < 4; ++k) {
+            difference = _mm256_or_si256(difference, _mm256_xor_si256(Load(lhs.word[k], i), Load(rhs.word[k], i)));
+        }
+        int equal_bits = _mm256_movemask_pd(
+            _mm256_castsi256_pd(_mm256_cmpeq_epi64(difference, _mm256_setzero_si256())));
+        for (uint8_t lane = 0; lane < 4; ++lane) {
+            result[i + lane] = ((equal_bits >> lane) & 1) != 0;
+        }
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2"))) size_t Avx2Sum(const NumberArray& values, ArrayLimbs& sum, size_t size) {
+    // четыре частичные суммы по дорожкам, в конце складываются между собой
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    __m256i total[4] = {_mm256_setzero_si256(), _mm256_setzero_si256(),
+                        _mm256_setzero_si256(), _mm256_setzero_si256()};
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        __m256i carry = _mm256_setzero_si256();
+        for (uint8_t k = 0; k < 4; ++k) {
+            __m256i a = total[k];
+            __m256i word_sum = _mm256_add_epi64(a, Load(values.word[k], i));
+            __m256i carry_out = _mm256_or_si256(LessUnsigned(word_sum, a),
+                                                _mm256_and_si256(carry, _mm256_cmpeq_epi64(word_sum, ones)));
+            total[k] = _mm256_sub_epi64(word_sum, carry);
+            carry = carry_out;
+        }
+    }
+    uint64_t lanes[4][4];
+    for (uint8_t k = 0; k < 4; ++k) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes[k]), total[k]);
+    }
+    for (uint8_t lane = 0; lane < 4; ++lane) {
+        sum = Add(sum, {{lanes[0][lane], lanes[1][lane], lanes[2][lane], lanes[3][lane]}});
+    }
+
+    return i;
+}
+#endif
+
+void AddArrays(const NumberArray& lhs, const NumberArray& rhs, NumberArray& result) {
+    size_t size = ArraySize(lhs);
+    ResizeArray(result, size);
+    size_t i = 0;
+#if defined(__x86_64__)
+    if (UseAvx2()) {
+        i = Avx2Add(lhs, rhs, result, size);
+    }
+#endif
+    for (; i < size; ++i) {
+        StoreLimbs(result, i, Add(LoadLimbs(lhs, i), LoadLimbs(rhs, i)));
+    }
+    for (size_t j = 0; j < size; ++j) {
+        // хранятся только младшие 32 бита сдвига, как и в operator+
+        result.shift[j] = lhs.shift[j] + rhs.shift[j];
+    }
+}
+
+void SubArrays(const NumberArray& lhs, const NumberArray& rhs, NumberArray& result) {
+    size_t size = ArraySize(lhs);
+    ResizeArray(result, size);
+    size_t i = 0;
+#if defined(__x86_64__)
+    if (UseAvx2()) {
+        i = Avx2Sub(lhs, rhs, result, size);
+    }
+#endif
+    for (; i < size; ++i) {
+        StoreLimbs(result, i, Sub(LoadLimbs(lhs, i), LoadLimbs(rhs, i)));
+    }
+    for (size_t j = 0; j < size; ++j) {
+        // operator- берёт разность сдвигов по модулю 2^35, от которой хранятся младшие 32 бита
+        result.shift[j] = lhs.shift[j] - rhs.shift[j];
+    }
+}
+
+void MulArrayByScalar(const NumberArray& values, uint32_t factor, NumberArray& result) {
+    size_t size = ArraySize(values);
+    ResizeArray(result, size);
+    size_t i = 0;
+#if defined(__x86_64__)
+    if (UseAvx2()) {
+        i = Avx2MulByScalar(values, factor, result, size);
+    }
+#endif
+    for (; i < size; ++i) {
+        ArrayLimbs product = LoadLimbs(values, i);
+        MulAddWord(product, factor, 0);
+        StoreLimbs(result, i, product);
+    }
+    // у FromInt(factor, 0) сдвиг 0, поэтому сдвиг не меняется
+    result.shift = values.shift;
+}
+
+void CompareArrays(const NumberArray& lhs, const NumberArray& rhs, int8_t* result) {
+    size_t size = ArraySize(lhs);
+    size_t i = 0;
+#if defined(__x86_64__)
+    if (UseAvx2()) {
+        i = Avx2Compare(lhs, rhs, result, size);
+    }
+#endif
+    for (; i < size; ++i) {
+        result[i] = Compare(LoadLimbs(lhs, i), LoadLimbs(rhs, i));
+    }
+}
+
+void EqualArrays(const NumberArray& lhs, const NumberArray& rhs, bool* result) {
+    size_t size = ArraySize(lhs);
+    size_t i = 0;
+#if defined(__x86_64__)
+    if (UseAvx2()) {
+        i = Avx2Equal(lhs, rhs, result, size);
+    }
+#endif
+    for (; i < size; ++i) {
+        result[i] = Compare(LoadLimbs(lhs, i), LoadLimbs(rhs, i)) == 0;
+    }
+}
+
+uint239_t SumArray(const NumberArray& values) {
+    size_t size = ArraySize(values);
+    ArrayLimbs sum = {};
+    size_t i = 0;
+#if defined(__x86_64__)
+    if (UseAvx2()) {
+        i = Avx2Sum(values, sum, size);
+    }
+#endif
+    for (; i < size; ++i) {
+        sum = Add(sum, LoadLimbs(values, i));
+    }
+    uint32_t shift = 0;
+    for (uint32_t value_shift: values.shift) {
+        shift += value_shift;
+    }
+
+    return MakeNumber<sizeof(uint239_t)>(sum, shift);
+}
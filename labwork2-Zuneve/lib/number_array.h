@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+
+#include "number.h"
+
+// Массив uint239_t в виде структуры массивов: word[k][i] - k-е 64-битное слово (младшее первое)
+// значения i-го числа без сдвига, shift[i] - его сдвиг. Одинаковые слова соседних чисел лежат подряд,
+// поэтому ядра ниже обрабатывают по 4 числа за инструкцию AVX2, а без неё - по одному.
+struct NumberArray {
+    std::vector<uint64_t> word[4];
+    std::vector<uint32_t> shift;
+};
+
+NumberArray MakeArray(const uint239_t* values, size_t count);
+
+size_t ArraySize(const NumberArray& array);
+
+uint239_t GetNumber(const NumberArray& array, size_t index);
+
+// "AVX2" или "scalar" - чем считают ядра на этом процессоре
+const char* ArrayInstructionSet();
+
+// true - ядра считают по одному числу даже там, где есть AVX2. Нужно тестам и замерам,
+// чтобы на одной машине проверить обе реализации; переключать, пока ядра работают в других потоках, нельзя.
+void ForceScalarArrays(bool force);
+
+// Во всех ядрах lhs и rhs одного размера, а result может быть тем же массивом, что и аргумент.
+// Значения и сдвиги результата такие же, как у соответствующего оператора над отдельными числами.
+
+// result[i] = lhs[i] + rhs[i]
+void AddArrays(const NumberArray& lhs, const NumberArray& rhs, NumberArray& result);
+
+// result[i] = lhs[i] - rhs[i]
+void SubArrays(const NumberArray& lhs, const NumberArray& rhs, NumberArray& result);
+
+// result[i] = values[i] * FromInt(factor, 0)
+void MulArrayByScalar(const NumberArray& values, uint32_t factor, NumberArray& result);
+
+// result[i] = -1, 0 или 1 - сравнение значений без сдвига
+void CompareArrays(const NumberArray& lhs, const NumberArray& rhs, int8_t* result);
+
+// result[i] = lhs[i] == rhs[i]
+void EqualArrays(const NumberArray& lhs, const NumberArray& rhs, bool* result);
+
+// Сумма всех чисел, как при сложении их по порядку через operator+ начиная с FromInt(0, 0)
+uint239_t SumArray(const NumberArray& values);
@@ -0,0 +1,131 @@
+#include <lib/number.h>
+#include <lib/number_array.h>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+
+// 103 числа - чтобы после четвёрок AVX2 остался хвост, который считается по одному
+std::vector<uint239_t> RandomNumbers(uint32_t seed, size_t count = 103) {
+    std::mt19937 random(seed);
+    std::vector<uint239_t> numbers;
+    for (size_t i = 0; i < count; ++i) {
+        std::string digits(1 + random() % 74, '0');
+        for (char& digit: digits) {
+            digit = static_cast<char>('0' + random() % 10);
+        }
+        numbers.push_back(FromString(digits.c_str(), random()));
+    }
+    // одинаковые, отличающиеся только сдвигом и с переносом через все слова
+    numbers[0] = numbers[1];
+    numbers[2] = FromString("56539106072908298546665520023773392506479484700019806659891398441363832831", 7);
+    numbers[3] = FromInt(1, 0);
+    return numbers;
+}
+
+bool SameBytes(const uint239_t& lhs, const uint239_t& rhs) {
+    return memcmp(lhs.data, rhs.data, sizeof(lhs.data)) == 0;
+}
+
+TEST(NumberArrayTest, RoundTrip) {
+    std::vector<uint239_t> numbers = RandomNumbers(1);
+    NumberArray array = MakeArray(numbers.data(), numbers.size());
+    ASSERT_EQ(ArraySize(array), numbers.size());
+    for (size_t i = 0; i < numbers.size(); ++i) {
+        ASSERT_TRUE(SameBytes(GetNumber(array, i), numbers[i])) << i;
+    }
+}
+
+// Ядра проверяются в обеих реализациях: параметр - считать ли по одному числу.
+// AVX2 пропускается, если процессор его не поддерживает.
+class NumberArrayKernelsTest : public testing::TestWithParam<bool> {
+protected:
+    void SetUp() override {
+        ForceScalarArrays(GetParam());
+        if (!GetParam() && std::string(ArrayInstructionSet()) != "AVX2") {
+            GTEST_SKIP() << "no AVX2";
+        }
+        ASSERT_EQ(std::string(ArrayInstructionSet()), GetParam() ? "scalar" : "AVX2");
+    }
+
+    void TearDown() override {
+        ForceScalarArrays(false);
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(Kernels, NumberArrayKernelsTest, testing::Values(false, true),
+                         [](const testing::TestParamInfo<bool>& info) { return info.param ? "Scalar" : "Avx2"; });
+
+TEST_P(NumberArrayKernelsTest, AddSubMatchOperators) {
+    std::vector<uint239_t> lhs = RandomNumbers(2);
+    std::vector<uint239_t> rhs = RandomNumbers(3);
+    rhs[2] = FromInt(1, 0);
+    NumberArray a = MakeArray(lhs.data(), lhs.size());
+    NumberArray b = MakeArray(rhs.data(), rhs.size());
+    NumberArray sum;
+    NumberArray difference;
+    AddArrays(a, b, sum);
+    SubArrays(a, b, difference);
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        ASSERT_TRUE(SameBytes(GetNumber(sum, i), lhs[i] + rhs[i])) << i;
+        ASSERT_TRUE(SameBytes(GetNumber(difference, i), lhs[i] - rhs[i])) << i;
+    }
+
+    // результат поверх аргумента
+    AddArrays(a, b, a);
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        ASSERT_TRUE(SameBytes(GetNumber(a, i), lhs[i] + rhs[i])) << i;
+    }
+}
+
+TEST_P(NumberArrayKernelsTest, MulByScalarMatchesOperator) {
+    std::vector<uint239_t> numbers = RandomNumbers(4);
+    NumberArray array = MakeArray(numbers.data(), numbers.size());
+    for (uint32_t factor: {0u, 1u, 10u, 4294967295u}) {
+        NumberArray product;
+        MulArrayByScalar(array, factor, product);
+        for (size_t i = 0; i < numbers.size(); ++i) {
+            ASSERT_TRUE(SameBytes(GetNumber(product, i), numbers[i] * FromInt(factor, 0))) << factor << ' ' << i;
+        }
+    }
+}
+
+TEST_P(NumberArrayKernelsTest, CompareAndEqual) {
+    std::vector<uint239_t> lhs = RandomNumbers(5);
+    std::vector<uint239_t> rhs = lhs;
+    std::mt19937 random(6);
+    for (size_t i = 0; i < rhs.size(); ++i) {
+        // часть чисел та же, но с другим сдвигом, часть отличается в одном из слов
+        if (i % 3 == 0) {
+            rhs[i] = rhs[i] + FromInt(random() % 2, 0);
+        } else if (i % 3 == 1) {
+            rhs[i] = rhs[i] * FromInt(1, random());
+        } else {
+            rhs[i] = RandomNumbers(i, 4)[1];
+        }
+    }
+    NumberArray a = MakeArray(lhs.data(), lhs.size());
+    NumberArray b = MakeArray(rhs.data(), rhs.size());
+    std::vector<int8_t> order(lhs.size());
+    bool equal[103];
+    CompareArrays(a, b, order.data());
+    EqualArrays(a, b, equal);
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        int8_t expected = lhs[i] == rhs[i] ? 0 : (lhs[i] < rhs[i] ? -1 : 1);
+        ASSERT_EQ(order[i], expected) << i;
+        ASSERT_EQ(equal[i], lhs[i] == rhs[i]) << i;
+    }
+}
+
+TEST_P(NumberArrayKernelsTest, SumMatchesOperator) {
+    std::vector<uint239_t> numbers = RandomNumbers(7);
+    NumberArray array = MakeArray(numbers.data(), numbers.size());
+    uint239_t expected = FromInt(0, 0);
+    for (const uint239_t& number: numbers) {
+        expected = expected + number;
+    }
+    ASSERT_TRUE(SameBytes(SumArray(array), expected));
+    ASSERT_TRUE(SameBytes(SumArray(MakeArray(numbers.data(), 0)), FromInt(0, 0)));
+}
@@ -0,0 +1,78 @@
+#include <lib/number.h>
+#include <gtest/gtest.h>
+#include <array>
+#include <cstring>
+#include <string>
+
+
+// Проверки на этапе компиляции: если какая-то операция перестанет быть constexpr
+// или посчитает неправильно, тесты просто не соберутся.
+
+constexpr bool SameBytes(const uint239_t& lhs, const uint239_t& rhs) {
+    for (uint8_t i = 0; i < 35; ++i) {
+        if (lhs.data[i] != rhs.data[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// таблица 10^0 .. 10^73 целиком считается компилятором
+constexpr std::array<uint239_t, 74> kPowersOfTen = []() {
+    std::array<uint239_t, 74> powers = {};
+    powers[0] = FromInt(1, 0);
+    for (size_t i = 1; i < powers.size(); ++i) {
+        powers[i] = powers[i - 1] * FromInt(10, 0);
+    }
+    return powers;
+}();
+
+static_assert(FromInt(239, 5) == FromString("239", 0));
+static_assert(GetShift(FromInt(1, 123456)) == 123456);
+static_assert(GetShift(FromString("2024", 4294967295u)) == 4294967295u);
+static_assert(SameBytes(FromString("1", 0), FromInt(1, 0)));
+
+static_assert(FromInt(2024, 2024) + FromInt(8, 239) == FromInt(2032, 0));
+static_assert(GetShift(FromInt(2024, 2024) + FromInt(8, 239)) == 2263);
+static_assert(FromInt(2024, 2024) - FromInt(8, 239) == FromInt(2016, 0));
+static_assert(GetShift(FromInt(2024, 2024) - FromInt(8, 239)) == 1785);
+static_assert(FromInt(876, 123) * FromInt(124, 48) == FromInt(108624, 0));
+static_assert(FromInt(876, 123) / FromInt(124, 48) == FromInt(7, 0));
+static_assert(FromInt(876, 123) % FromInt(124, 48) == FromInt(8, 0));
+static_assert(FromInt(876, 1) < FromInt(877, 0) && FromInt(877, 1) > FromInt(876, 0));
+static_assert(FromInt(5, 1) != FromInt(6, 1));
+static_assert([]() {
+    uint239_t value = FromInt(876, 123);
+    value += FromInt(124, 48);
+    value *= FromInt(3, 0);
+    value -= FromInt(1000, 0);
+    value /= FromInt(7, 2);
+    MulAdd(value, FromInt(10, 0), FromInt(10, 0));
+    return value == FromInt(385, 0) && GetShift(value) == 169;
+}());
+
+static_assert(kPowersOfTen[18] == FromString("1000000000000000000", 0));
+static_assert(kPowersOfTen[73] == FromString("1" "000000000000000000" "000000000000000000"
+                                             "000000000000000000" "000000000000000000" "0", 0));
+static_assert(kPowersOfTen[73] / kPowersOfTen[55] == kPowersOfTen[18]);
+// 2^245 - 1 + 1 == 0
+static_assert(FromString("56539106072908298546665520023773392506479484700019806659891398441363832831", 3)
+              + FromInt(1, 0) == FromInt(0, 0));
+
+// другие ширины: 28 бит и 4 бита сдвига, 896 бит
+static_assert(FromInt<4>(300, 17) * FromInt<4>(1000000, 0) == FromInt<4>(300000000 - (1 << 28), 0));
+static_assert(GetShift(FromInt<4>(300, 17)) == 1);
+static_assert(GetShift(FromInt<4>(1, 3) - FromInt<4>(1, 5)) == 14);
+static_assert(FromString<128>("1" "000000000000000000" "000000000000000000" "000000000000000000"
+                              "000000000000000000" "000000000000000000" "000000000000000000", 7)
+              / FromString<128>("1" "000000000000000000" "000000000000000000" "000000000000000000", 3)
+              == FromString<128>("1" "000000000000000000" "000000000000000000" "000000000000000000", 0));
+
+TEST(ConstexprTest, TableMatchesRuntime) {
+    uint239_t power = FromInt(1, 0);
+    for (size_t i = 0; i < kPowersOfTen.size(); ++i) {
+        ASSERT_TRUE(SameBytes(kPowersOfTen[i], power)) << i;
+        ASSERT_TRUE(SameBytes(kPowersOfTen[i], FromString(("1" + std::string(i, '0')).c_str(), 0))) << i;
+        power = power * FromInt(10, 0);
+    }
+}
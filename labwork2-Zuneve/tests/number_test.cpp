@@ -2,6 +2,9 @@
 #include <gtest/gtest.h>
 #include <bitset>
 #include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
 #include <tuple>
 
 
@@ -172,3 +175,216 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(TValue{"1000", 1000}, TValue{"2", 999}, TValue{"1002", 1999}, TValue{"998", 1},  TValue{"2000", 1999}, TValue{"500", 1})
     )
 );
+
+
+TEST(DecimalTest, PrintRoundTrip) {
+    // границы кусков по 18 цифр и максимальное значение 2^245 - 1
+    const char* values[] = {
+        "0", "7", "999999999999999999", "1000000000000000000", "1000000000000000001",
+        "123456789012345678901234567890123456789",
+        "56539106072908298546665520023773392506479484700019806659891398441363832831"
+    };
+    for (const char* value: values) {
+        std::ostringstream printed;
+        printed << FromString(value, 239);
+        ASSERT_EQ(printed.str(), value);
+    }
+}
+
+TEST(DecimalTest, ValuesWrapModulo) {
+    // 2^245 - 1 + 1 == 0
+    uint239_t max = FromString("56539106072908298546665520023773392506479484700019806659891398441363832831", 0);
+    ASSERT_EQ(max + FromInt(1, 0), FromInt(0, 0));
+}
+
+TEST(DecimalTest, BatchRoundTrip) {
+    const char input[] = "12 0\n340282366920938463463374607431768211456, 99999999999999999999";
+    uint239_t values[5];
+    size_t count = ParseNumbers(input, sizeof(input) - 1, 5, values, 5);
+    ASSERT_EQ(count, 4);
+    ASSERT_EQ(values[0], FromInt(12, 0));
+    ASSERT_EQ(GetShift(values[0]), 5);
+    ASSERT_EQ(values[2], FromString("340282366920938463463374607431768211456", 0));
+
+    char output[4 * (kMaxDecimalLength + 1)];
+    size_t length = FormatNumbers(values, count, output);
+    ASSERT_EQ(std::string(output, length), "12\n0\n340282366920938463463374607431768211456\n99999999999999999999\n");
+    ASSERT_EQ(ParseNumbers(input, sizeof(input) - 1, 0, values, 2), 2);
+}
+
+bool SameNumber(const uint239_t& lhs, const uint239_t& rhs) {
+    return memcmp(lhs.data, rhs.data, sizeof(lhs.data)) == 0;
+}
+
+TEST(CompoundTest, MatchesBinaryOperators) {
+    // результат вместе со сдвигом побайтно совпадает с обычными операторами
+    const TValue values[] = {{"2024", 2024}, {"8", 239}, {"99999999999999999999", 99}, {"1000", 1000}, {"3", 4000000000u}};
+    for (const TValue& left: values) {
+        for (const TValue& right: values) {
+            uint239_t a = FromString(left.first, left.second);
+            uint239_t b = FromString(right.first, right.second);
+            uint239_t result = a;
+            ASSERT_TRUE(SameNumber(result += b, a + b));
+            result = a;
+            ASSERT_TRUE(SameNumber(result -= b, a - b));
+            result = a;
+            ASSERT_TRUE(SameNumber(result *= b, a * b));
+            result = a;
+            ASSERT_TRUE(SameNumber(result /= b, a / b));
+            result = a;
+            ASSERT_TRUE(SameNumber(result %= b, a % b));
+            result = a;
+            ASSERT_TRUE(SameNumber(MulAdd(result, a, b), a + a * b));
+        }
+    }
+}
+
+TEST(CompoundTest, SameObjectOnBothSides) {
+    uint239_t a = FromString("123456789123456789123456789", 17);
+    uint239_t expected = a + a;
+    a += a;
+    ASSERT_TRUE(SameNumber(a, expected));
+    expected = a * a;
+    a *= a;
+    ASSERT_TRUE(SameNumber(a, expected));
+    expected = a + a * a;
+    MulAdd(a, a, a);
+    ASSERT_TRUE(SameNumber(a, expected));
+    a -= a;
+    ASSERT_EQ(a, FromInt(0, 0));
+}
+
+TEST(CompareTest, MatchesDeshiftedValues) {
+    // одинаковые и разные повороты, значения отличаются в старших, младших или всех битах
+    std::mt19937 random(239);
+    auto random_number = [&random](uint32_t shift) {
+        std::string digits(1 + random() % 74, '0');
+        for (char& digit: digits) {
+            digit = static_cast<char>('0' + random() % 10);
+        }
+        return FromString(digits.c_str(), shift);
+    };
+    for (int32_t i = 0; i < 20000; ++i) {
+        uint32_t shift = random();
+        uint239_t a = random_number(shift);
+        uint239_t b;
+        switch (i % 4) {
+            case 0:
+                b = random_number(shift + 245 * (random() % 100));
+                break;
+            case 1:
+                b = random_number(random());
+                break;
+            case 2:
+                b = a + FromInt(random() % 3, random() % 245);
+                break;
+            default:
+                // тот же сдвиг, отличается только в старших цифрах
+                b = a + FromString("1000000000000000000000000000000000000000000000000000000000000000000000000", 0);
+        }
+        int8_t expected = limbs::Compare(limbs::ValueOf(a), limbs::ValueOf(b));
+        ASSERT_EQ((a <=> b) < 0, expected < 0) << i;
+        ASSERT_EQ((a <=> b) == 0, expected == 0) << i;
+        ASSERT_EQ(a == b, expected == 0) << i;
+        ASSERT_EQ(a < b, expected < 0) << i;
+        ASSERT_EQ(b < a, expected > 0) << i;
+    }
+}
+
+TEST(CompareTest, SameValueDifferentShift) {
+    uint239_t a = FromString("123456789", 0);
+    uint239_t b = FromString("123456789", 100);
+    ASSERT_TRUE((a <=> b) == 0);
+    ASSERT_TRUE(FromInt(5, 3) <=> FromInt(6, 247) < 0);
+    ASSERT_TRUE(FromInt(7, 490) <=> FromInt(6, 0) > 0);
+}
+
+template <size_t Bytes>
+std::string Decimal(const uintN_itmo_t<Bytes>& value) {
+    std::ostringstream stream;
+    stream << value;
+    return stream.str();
+}
+
+template <size_t Bytes>
+void CheckAgainstMachineWords(uint32_t seed) {
+    // значение помещается в uint64_t: ответы по модулю 2^(7 * Bytes), сдвиг хранится в Bytes служебных битах
+    const uint64_t value_mask = (1ull << (7 * Bytes)) - 1;
+    const uint64_t shift_mask = (1ull << Bytes) - 1;
+    std::mt19937_64 random(seed);
+    for (int32_t i = 0; i < 2000; ++i) {
+        uint64_t x = random() & value_mask;
+        uint64_t y = (random() >> (random() % 64)) & value_mask;
+        uint32_t x_shift = random();
+        uint32_t y_shift = random();
+        uintN_itmo_t<Bytes> a = FromString<Bytes>(std::to_string(x).c_str(), x_shift);
+        uintN_itmo_t<Bytes> b = FromString<Bytes>(std::to_string(y).c_str(), y_shift);
+        ASSERT_EQ(Decimal(a), std::to_string(x));
+        ASSERT_EQ(GetShift(a), x_shift & shift_mask);
+        ASSERT_EQ(Decimal(a + b), std::to_string((x + y) & value_mask));
+        ASSERT_EQ(GetShift(a + b), (GetShift(a) + GetShift(b)) & shift_mask);
+        ASSERT_EQ(Decimal(a - b), std::to_string((x - y) & value_mask));
+        ASSERT_EQ(GetShift(a - b), (GetShift(a) - GetShift(b)) & shift_mask);
+        ASSERT_EQ(Decimal(a * b), std::to_string((x * y) & value_mask));
+        if (y != 0) {
+            ASSERT_EQ(Decimal(a / b), std::to_string(x / y));
+            ASSERT_EQ(Decimal(a % b), std::to_string(x % y));
+        }
+        ASSERT_EQ(a < b, x < y);
+        ASSERT_EQ(a == b, x == y);
+    }
+}
+
+TEST(WidthTest, NarrowMatchesMachineWords) {
+    CheckAgainstMachineWords<4>(4);
+    CheckAgainstMachineWords<7>(7);
+    CheckAgainstMachineWords<9>(9);
+}
+
+TEST(WidthTest, WideMatchesUint239) {
+    // пока результат меньше 2^245, 128-байтное число считает так же, как uint239_t
+    std::mt19937 random(128);
+    auto random_digits = [&random](size_t max_length) {
+        std::string digits(1 + random() % max_length, '0');
+        for (char& digit: digits) {
+            digit = static_cast<char>('0' + random() % 10);
+        }
+        // без ведущего нуля, чтобы делитель не оказался нулём
+        digits[0] = static_cast<char>('1' + random() % 9);
+        return digits;
+    };
+    for (int32_t i = 0; i < 2000; ++i) {
+        std::string x = random_digits(36);
+        std::string y = random_digits(36);
+        uint32_t shift = random();
+        uint239_t a = FromString(x.c_str(), shift);
+        uint239_t b = FromString(y.c_str(), shift / 3);
+        uintN_itmo_t<128> wide_a = FromString<128>(x.c_str(), shift);
+        uintN_itmo_t<128> wide_b = FromString<128>(y.c_str(), shift / 3);
+        ASSERT_EQ(Decimal(wide_a * wide_b + wide_a), Decimal(a * b + a));
+        ASSERT_EQ(Decimal(wide_a / wide_b), Decimal(a / b));
+        ASSERT_EQ(Decimal(wide_a % wide_b), Decimal(a % b));
+        ASSERT_EQ(GetShift(wide_a - wide_b), GetShift(a - b));
+        ASSERT_EQ(wide_a < wide_b, a < b);
+    }
+    for (int32_t i = 0; i < 500; ++i) {
+        // значения больше 2^245
+        uintN_itmo_t<128> a = FromString<128>(random_digits(130).c_str(), random());
+        uintN_itmo_t<128> b = FromString<128>(random_digits(130).c_str(), random());
+        uintN_itmo_t<128> product = a * b;
+        ASSERT_EQ(product / b, a);
+        ASSERT_EQ(product % b, FromInt<128>(0, 0));
+        ASSERT_EQ(FromString<128>(Decimal(product).c_str(), 0), product);
+        ASSERT_EQ(product - a + a, product);
+    }
+}
+
+TEST(WidthTest, WideWrapsAround) {
+    // 2^896 - 1 занимает 270 цифр
+    uintN_itmo_t<128> max = FromInt<128>(0, 0) - FromInt<128>(1, 0);
+    ASSERT_EQ(Decimal(max).size(), 270);
+    ASSERT_LE(Decimal(max).size(), kMaxDecimalLengthOf<128>);
+    ASSERT_EQ(max + FromInt<128>(1, 1000), FromInt<128>(0, 0));
+    // как и у uint239_t, хранятся только младшие 32 бита сдвига
+    ASSERT_EQ(GetShift(FromInt<128>(1, 4294967295u) + FromInt<128>(1, 4294967295u)), 4294967294u);
+}